@@ -1,12 +1,15 @@
 #version 450
 
 layout(binding = 0) uniform UniformBufferObject {
-    mat4    model;
     mat4    view;
     mat4    proj;
-    vec4    pos;
 } ubo;
 
+layout(push_constant) uniform PushConstants {
+    mat4    model;
+    vec4    pos;
+} pc;
+
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
@@ -14,6 +17,6 @@ layout(location = 2) in vec2 inTexCoord;
 layout(location = 0) out vec2 fragTexCoord;
 
 void main() {
-    gl_Position = ubo.proj * ubo.view * (ubo.model * vec4(inPosition, 1.0) + ubo.pos);
+    gl_Position = ubo.proj * ubo.view * (pc.model * vec4(inPosition, 1.0) + pc.pos);
     fragTexCoord = inTexCoord;
 }
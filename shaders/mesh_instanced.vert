@@ -0,0 +1,27 @@
+#version 450
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4    view;
+    mat4    proj;
+} ubo;
+
+layout(push_constant) uniform PushConstants {
+    mat4    model;
+    vec4    pos;
+} pc;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;
+
+// Per instance data, see InstancePos
+layout(location = 3) in vec3 instancePosition;
+layout(location = 4) in float instanceScale;
+
+layout(location = 0) out vec2 fragTexCoord;
+
+void main() {
+    vec4 worldPos = pc.model * vec4(inPosition * instanceScale, 1.0) + pc.pos + vec4(instancePosition, 0.0);
+    gl_Position = ubo.proj * ubo.view * worldPos;
+    fragTexCoord = inTexCoord;
+}
@@ -0,0 +1,14 @@
+#ifndef BENCH_HPP
+# define BENCH_HPP
+
+# include <defineCore.hpp>
+
+# include <benchmark/benchmark.h>
+
+// Iterations are pinned, so runs of different builds do the same work
+# define BENCH_ITERATIONS 100000
+# define BENCH_SMALL_ITERATIONS 100
+// Inputs are generated from a fixed seed
+# define BENCH_SEED 42
+
+#endif
@@ -0,0 +1,32 @@
+#include <bench/bench.hpp>
+
+#include <engine/camera/Camera.hpp>
+
+// setRotation compute rotation vectors then view matrix
+static void	cameraRotation(benchmark::State &state)
+{
+	Camera	camera;
+	float	yaw = 0.0f;
+
+	for (auto _ : state)
+	{
+		camera.setRotation(-20.0f, yaw, 0.0f);
+		benchmark::DoNotOptimize(camera.getView());
+		yaw += 0.1f;
+	}
+}
+BENCHMARK(cameraRotation)->Iterations(BENCH_ITERATIONS);
+
+
+// Moves only compute view matrix
+static void	cameraView(benchmark::State &state)
+{
+	Camera	camera;
+
+	for (auto _ : state)
+	{
+		camera.moveFront(0.01f);
+		benchmark::DoNotOptimize(camera.getView());
+	}
+}
+BENCHMARK(cameraView)->Iterations(BENCH_ITERATIONS);
@@ -0,0 +1,3 @@
+#include <bench/bench.hpp>
+
+BENCHMARK_MAIN();
@@ -0,0 +1,61 @@
+#include <bench/bench.hpp>
+
+#include <engine/mesh/Vertex.hpp>
+#include <engine/mesh/MeshOptimizer.hpp>
+#include <test/grid.hpp>
+
+#include <random>
+#include <vector>
+
+static std::vector<Vertex>	generateVertices(size_t nbVertices);
+
+static void	vertexHash(benchmark::State &state)
+{
+	std::vector<Vertex>	vertices = generateVertices(1024);
+	size_t				i = 0;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(vertices[i].getHash());
+		i = (i + 1) % vertices.size();
+	}
+}
+BENCHMARK(vertexHash)->Iterations(BENCH_ITERATIONS);
+
+
+// Grid with shuffled triangles, worst case order for vertex cache
+static void	meshOptimizeVertexCache(benchmark::State &state)
+{
+	uint32_t				size = static_cast<uint32_t>(state.range(0));
+	uint32_t				nbVertex = (size + 1) * (size + 1);
+	std::vector<uint32_t>	source = generateGridIndices(size, BENCH_SEED);
+	std::vector<uint32_t>	indices;
+
+	for (auto _ : state)
+	{
+		indices = source;
+		optimizeVertexCache(indices, nbVertex);
+		benchmark::DoNotOptimize(indices.data());
+	}
+	state.SetItemsProcessed(state.iterations() * source.size() / 3);
+	// Cache simulation is out of the timed loop, output is the same each run
+	state.counters["acmrBefore"] = computeAcmr(source, nbVertex);
+	state.counters["acmrAfter"] = computeAcmr(indices, nbVertex);
+}
+BENCHMARK(meshOptimizeVertexCache)->Arg(128)->Iterations(BENCH_SMALL_ITERATIONS);
+
+
+static std::vector<Vertex>	generateVertices(size_t nbVertices)
+{
+	std::mt19937							generator(BENCH_SEED);
+	std::uniform_real_distribution<float>	distribution(-1.0f, 1.0f);
+	std::vector<Vertex>						vertices;
+
+	for (size_t i = 0; i < nbVertices; i++)
+		vertices.push_back(Vertex(
+			gm::Vec3f(distribution(generator), distribution(generator), distribution(generator)),
+			gm::Vec3f(distribution(generator), distribution(generator), distribution(generator)),
+			gm::Vec2f(distribution(generator), distribution(generator))));
+
+	return (vertices);
+}
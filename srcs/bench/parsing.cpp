@@ -0,0 +1,150 @@
+#include <bench/bench.hpp>
+
+#include <program/parsing/string.hpp>
+#include <program/parsing/obj.hpp>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static std::vector<std::string>	generateFloats(size_t nbFloats);
+static std::string				generateObj(uint32_t size);
+
+// Typical obj vertex line
+static void	parsingSplit(benchmark::State &state)
+{
+	const std::string	line = "v 0.123456 -1.654321 12.500000";
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(split(line, ' '));
+	state.SetBytesProcessed(state.iterations() * line.size());
+}
+BENCHMARK(parsingSplit)->Iterations(BENCH_ITERATIONS);
+
+
+static void	parsingSplitView(benchmark::State &state)
+{
+	const std::string	line = "v 0.123456 -1.654321 12.500000";
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(splitView(line, ' '));
+	state.SetBytesProcessed(state.iterations() * line.size());
+}
+BENCHMARK(parsingSplitView)->Iterations(BENCH_ITERATIONS);
+
+
+static void	parsingSplitLazy(benchmark::State &state)
+{
+	const std::string	line = "v 0.123456 -1.654321 12.500000";
+
+	for (auto _ : state)
+	{
+		for (std::string_view token : splitLazy(line, ' '))
+			benchmark::DoNotOptimize(token);
+	}
+	state.SetBytesProcessed(state.iterations() * line.size());
+}
+BENCHMARK(parsingSplitLazy)->Iterations(BENCH_ITERATIONS);
+
+
+static void	parsingStrToFloat(benchmark::State &state)
+{
+	std::vector<std::string>	floats = generateFloats(1024);
+	size_t						i = 0;
+	float						value;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(strToFloat(floats[i], value));
+		benchmark::DoNotOptimize(value);
+		i = (i + 1) % floats.size();
+	}
+}
+BENCHMARK(parsingStrToFloat)->Iterations(BENCH_ITERATIONS);
+
+
+static void	parsingStrToInt(benchmark::State &state)
+{
+	const std::string	number = "-1234567";
+	int					value;
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(strToInt(number, value));
+		benchmark::DoNotOptimize(value);
+	}
+}
+BENCHMARK(parsingStrToInt)->Iterations(BENCH_ITERATIONS);
+
+
+// Whole obj parsing from memory, corners shared by quads are merged
+static void	parsingObj(benchmark::State &state)
+{
+	const std::string		data = generateObj(static_cast<uint32_t>(state.range(0)));
+	const std::string		path = "generated.obj";
+	std::vector<Vertex>		vertices;
+	std::vector<uint32_t>	indices;
+
+	for (auto _ : state)
+	{
+		parseObjData(data, path, vertices, indices);
+		benchmark::DoNotOptimize(vertices.data());
+		benchmark::DoNotOptimize(indices.data());
+	}
+	state.SetBytesProcessed(state.iterations() * data.size());
+	state.counters["vertices"] = vertices.size();
+	state.counters["triangles"] = indices.size() / 3;
+}
+BENCHMARK(parsingObj)->Arg(256)->Iterations(BENCH_SMALL_ITERATIONS);
+
+
+static std::vector<std::string>	generateFloats(size_t nbFloats)
+{
+	std::mt19937							generator(BENCH_SEED);
+	std::uniform_real_distribution<float>	distribution(-100.0f, 100.0f);
+	std::vector<std::string>				floats;
+
+	for (size_t i = 0; i < nbFloats; i++)
+		floats.push_back(std::to_string(distribution(generator)));
+
+	return (floats);
+}
+
+
+// Grid of size * size quads, with texture coordinates and one normal
+static std::string	generateObj(uint32_t size)
+{
+	std::mt19937							generator(BENCH_SEED);
+	std::uniform_real_distribution<float>	distribution(-0.1f, 0.1f);
+	std::string								data;
+
+	for (uint32_t y = 0; y <= size; y++)
+	{
+		for (uint32_t x = 0; x <= size; x++)
+		{
+			data += "v " + std::to_string(static_cast<float>(x)) + " "
+					+ std::to_string(distribution(generator)) + " "
+					+ std::to_string(static_cast<float>(y)) + "\n";
+			data += "vt " + std::to_string(static_cast<float>(x) / size) + " "
+					+ std::to_string(static_cast<float>(y) / size) + "\n";
+		}
+	}
+	data += "vn 0.000000 1.000000 0.000000\n";
+
+	for (uint32_t y = 0; y < size; y++)
+	{
+		for (uint32_t x = 0; x < size; x++)
+		{
+			uint32_t	a = y * (size + 1) + x + 1;
+			uint32_t	corners[4] = {a, a + size + 1, a + size + 2, a + 1};
+
+			data += "f";
+			for (uint32_t corner : corners)
+				data += " " + std::to_string(corner) + "/" + std::to_string(corner) + "/1";
+			data += "\n";
+		}
+	}
+
+	return (data);
+}
@@ -20,28 +20,7 @@
 # define GLFW_EXPOSE_NATIVE_XCB
 # include <GLFW/glfw3native.h>
 
-// Global defines
-# define PRINT_FPS_TIME 1.0
-
-// Window defines
-# define WIN_TITLE "scop"
-# define ENGINE_TITLE "gvEngine"
-# define WIN_W 1600
-# define WIN_H 900
-
-// Camera defines
-# define FOV 80.0f
-# define NEAR 0.1f
-# define FAR 1000.0f
-# define SPEED 3.0f
-# define SPRINT 5.0f
-# define ROTATE 45.0f
-
-const int MAX_FRAMES_IN_FLIGHT = 2;
-
-// Chunk defines
-# define CHUNK_SIZE 32
-const int	CHUNK_SIZE2 = CHUNK_SIZE * CHUNK_SIZE;
-const int	CHUNK_SIZE3 = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
+// Constants
+# include <defineCore.hpp>
 
 #endif
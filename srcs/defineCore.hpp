@@ -0,0 +1,69 @@
+#ifndef DEFINE_CORE_HPP
+# define DEFINE_CORE_HPP
+
+// Constants without GLFW nor Vulkan, usable by cpu only code
+
+// Global defines
+# define PRINT_FPS_TIME 1.0
+
+// Window defines
+# define WIN_TITLE "scop"
+# define ENGINE_TITLE "gvEngine"
+# define WIN_W 1600
+# define WIN_H 900
+// Headless rendering, frames use a fixed delta to be reproducible
+# define HEADLESS_NB_FRAMES 60
+# define HEADLESS_DELTA (1.0 / 60.0)
+# define HEADLESS_OUTPUT "frame.ppm"
+# define BENCHMARK_OUTPUT "benchmark.csv"
+// Instanced draw of headless and benchmark modes, instances on a square grid
+# define INSTANCES_SPACING 1.5f
+
+// Camera defines
+# define FOV 80.0f
+# define NEAR 0.1f
+# define FAR 1000.0f
+# define SPEED 3.0f
+# define SPRINT 5.0f
+# define ROTATE 45.0f
+
+const int MAX_FRAMES_IN_FLIGHT = 2;
+// Max gpu profiler scopes per frame
+# define GPU_PROFILER_MAX_SCOPES 32
+// Max gpu profiler uploads in flight, next ones aren't timed
+# define GPU_PROFILER_MAX_UPLOADS 64
+// Under this number of draws per thread, draws are recorded without threads
+# define MIN_DRAWS_PER_RECORD_JOB 64
+// Per frame transient allocations, reset each frame
+# define FRAME_UNIFORM_BUFFER_SIZE (1 << 22)
+# define FRAME_MAX_DESCRIPTOR_SETS 4096
+# define FRAME_MAX_DESCRIPTORS 8192
+// Max ubo per shader, each one take a dynamic offset in draw commands
+# define SHADER_MAX_UBO 4
+// Minimal push constants size guaranteed by Vulkan
+# define SHADER_MAX_PUSH_CONSTANTS_SIZE 128
+// Shader hot reload directories, GLSL sources and compiled SPIR-V.
+// Meson gives the absolute sources path, so it works from release directory
+# ifndef SHADER_SRC_DIR
+#  define SHADER_SRC_DIR "shaders"
+# endif
+# define SHADER_BIN_DIR "shadersbin"
+// Cpu trace, only with meson option trace. Events per thread, then dropped
+# define TRACE_BUFFER_SIZE (1 << 16)
+# define TRACE_OUTPUT "trace.json"
+// Binary mesh cache, written next to parsed models. Bump version when layout change
+# define MESH_CACHE_EXTENSION ".vxcache"
+# define MESH_CACHE_VERSION 2
+// Dirty ranges kept per mesh buffer before merging them all in one
+# define MESH_MAX_DIRTY_RANGES 16
+// Mesh optimizer, post transform cache simulated as fifo of this size
+# define MESH_OPTIMIZER_CACHE_SIZE 32
+// Minimal triangles per cluster sorted for overdraw
+# define MESH_OPTIMIZER_CLUSTER_SIZE 64
+
+// Chunk defines
+# define CHUNK_SIZE 32
+const int	CHUNK_SIZE2 = CHUNK_SIZE * CHUNK_SIZE;
+const int	CHUNK_SIZE3 = CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef CAMERA_HPP
 # define CAMERA_HPP
 
-# include <define.hpp>
+# include <defineCore.hpp>
 
 # include <gmath.hpp>
 
@@ -1,19 +1,38 @@
 # include <engine/engine.hpp>
 
+# include <thread>
+
+Engine::Engine(bool headless) : window(headless)
+{
+	this->glfwWindow = NULL;
+}
+
+
 void	initEngine(Engine &engine)
 {
 	engine.context.init(engine.commandPool, engine.window);
 	engine.glfwWindow = engine.window.getWindow();
 
-	engine.inputManager = InputManager(engine.glfwWindow);
+	// Caller thread records too, so keep one core for it
+	uint32_t	nbCores = std::thread::hardware_concurrency();
+	engine.jobPool.init(nbCores > 1 ? nbCores - 1 : 0);
+	engine.commandPool.createThreadPools(engine.jobPool.getNbThreads());
+	engine.window.setJobPool(engine.jobPool);
+
+	// Headless engine has no window to read inputs from
+	if (!engine.window.isHeadless())
+		engine.inputManager = InputManager(engine.glfwWindow);
 }
 
 
 void	destroyEngine(Engine &engine)
 {
-	engine.textureManager.destroyImages(engine.context.getDevice());
+	engine.shaderWatcher.destroy();
+	engine.jobPool.destroy();
+	engine.textureManager.destroyImages(engine.commandPool);
 	engine.commandPool.destroy(engine.context.getDevice());
 	engine.window.destroy(engine.context.getInstance());
 	engine.context.destroy();
-	glfwDestroyWindow(engine.glfwWindow);
+	if (engine.glfwWindow != NULL)
+		glfwDestroyWindow(engine.glfwWindow);
 }
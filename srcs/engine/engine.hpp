@@ -3,6 +3,8 @@
 
 # include <define.hpp>
 
+# include <engine/jobs/JobPool.hpp>
+# include <engine/shader/ShaderWatcher.hpp>
 # include <engine/window/Window.hpp>
 # include <engine/inputs/InputManager.hpp>
 # include <engine/vulkan/VulkanContext.hpp>
@@ -11,12 +13,21 @@
 
 struct Engine
 {
+	/**
+	 * @brief Constructor of engine.
+	 *
+	 * @param headless If true, render offscreen without glfw window.
+	 */
+	Engine(bool headless = false);
+
 	VulkanContext		context;
 	VulkanCommandPool	commandPool;
 	Window				window;
 	GLFWwindow			*glfwWindow;
 	TextureManager		textureManager;
 	InputManager		inputManager;
+	JobPool				jobPool;
+	ShaderWatcher		shaderWatcher;
 };
 
 /**
@@ -0,0 +1,195 @@
+#include <engine/jobs/JobPool.hpp>
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+
+JobPool::JobPool(void)
+{
+	this->job = NULL;
+	this->nbJobs = 0;
+	this->nextJob = 0;
+	this->nbJobsDone = 0;
+	this->nbActiveWorkers = 0;
+	this->generation = 0;
+	this->stop = false;
+	this->exception = NULL;
+}
+
+//---- Destructor --------------------------------------------------------------
+
+JobPool::~JobPool()
+{
+	this->destroy();
+}
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+
+uint32_t	JobPool::getNbThreads(void) const
+{
+	return (static_cast<uint32_t>(this->workers.size()) + 1);
+}
+
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+//---- Creation ----------------------------------------------------------------
+
+void	JobPool::init(uint32_t nbWorkers)
+{
+	this->destroy();
+
+	this->stop = false;
+	for (uint32_t i = 0; i < nbWorkers; i++)
+		this->workers.emplace_back(&JobPool::workerLoop, this, i + 1);
+}
+
+//---- Free --------------------------------------------------------------------
+
+void	JobPool::destroy(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->stop = true;
+	}
+	this->startCondition.notify_all();
+
+	for (std::thread &worker : this->workers)
+		worker.join();
+	this->workers.clear();
+}
+
+//---- Jobs --------------------------------------------------------------------
+
+void	JobPool::run(uint32_t nbJobs, const Job &job)
+{
+	if (nbJobs == 0)
+		return ;
+
+	// Without worker, no need to synchronise
+	if (this->workers.empty())
+	{
+		std::exception_ptr	exception;
+
+		for (uint32_t i = 0; i < nbJobs; i++)
+		{
+			try
+			{
+				job(i, 0);
+			}
+			catch (...)
+			{
+				if (!exception)
+					exception = std::current_exception();
+			}
+		}
+		if (exception)
+			std::rethrow_exception(exception);
+		return ;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+
+		// Wait late workers of previous run before changing the job
+		this->endCondition.wait(lock, [this] { return (this->nbActiveWorkers == 0); });
+
+		this->job = &job;
+		this->nbJobs = nbJobs;
+		this->nextJob = 0;
+		this->nbJobsDone = 0;
+		this->exception = NULL;
+		this->generation++;
+	}
+	this->startCondition.notify_all();
+
+	this->executeJobs(0);
+
+	std::exception_ptr	exception;
+	{
+		std::unique_lock<std::mutex> lock(this->mutex);
+		this->endCondition.wait(lock, [this]
+			{
+				return (this->nbJobsDone == this->nbJobs && this->nbActiveWorkers == 0);
+			});
+		this->job = NULL;
+		exception = this->exception;
+		this->exception = NULL;
+	}
+
+	// Thrown once every job is done, so the pool is ready for next run
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+//**** STATIC METHODS **********************************************************
+//**** PRIVATE METHODS *********************************************************
+
+void	JobPool::workerLoop(uint32_t threadId)
+{
+	uint64_t	lastGeneration = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->startCondition.wait(lock, [this, &lastGeneration]
+				{
+					return (this->stop || this->generation != lastGeneration);
+				});
+
+			if (this->stop)
+				return ;
+
+			lastGeneration = this->generation;
+			this->nbActiveWorkers++;
+		}
+
+		this->executeJobs(threadId);
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->nbActiveWorkers--;
+		}
+		this->endCondition.notify_all();
+	}
+}
+
+
+void	JobPool::executeJobs(uint32_t threadId)
+{
+	uint32_t	nbDone = 0;
+	uint32_t	jobId;
+
+	while (true)
+	{
+		jobId = this->nextJob.fetch_add(1);
+		if (jobId >= this->nbJobs)
+			break ;
+		try
+		{
+			(*this->job)(jobId, threadId);
+		}
+		catch (...)
+		{
+			// An exception on a worker would terminate the program
+			std::lock_guard<std::mutex> lock(this->mutex);
+			if (!this->exception)
+				this->exception = std::current_exception();
+		}
+		nbDone++;
+	}
+
+	if (nbDone == 0)
+		return ;
+
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->nbJobsDone += nbDone;
+	}
+	this->endCondition.notify_all();
+}
+
+//**** FUNCTIONS ***************************************************************
+//**** STATIC FUNCTIONS ********************************************************
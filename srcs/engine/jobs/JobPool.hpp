@@ -0,0 +1,117 @@
+#ifndef JOB_POOL_HPP
+# define JOB_POOL_HPP
+
+# include <defineCore.hpp>
+
+# include <vector>
+# include <thread>
+# include <mutex>
+# include <atomic>
+# include <exception>
+# include <functional>
+# include <condition_variable>
+
+/**
+ * @brief Job function. Take the job id and the id of the thread running it.
+ */
+using Job = std::function<void(uint32_t jobId, uint32_t threadId)>;
+
+/**
+ * @brief Class for a pool of persistent worker threads running jobs in parallel.
+ */
+class JobPool
+{
+public:
+//**** PUBLIC ATTRIBUTS ********************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Default contructor of JobPool class.
+	 *
+	 * @return The default JobPool, without worker. Jobs run on caller thread.
+	 */
+	JobPool(void);
+
+//---- Destructor --------------------------------------------------------------
+	/**
+	 * @brief Destructor of JobPool class.
+	 */
+	~JobPool();
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+	/**
+	 * @brief Get the number of threads that run jobs, caller thread included.
+	 *
+	 * @return Number of threads as uint32.
+	 */
+	uint32_t	getNbThreads(void) const;
+
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+//---- Creation ----------------------------------------------------------------
+	/**
+	 * @brief Start worker threads.
+	 *
+	 * @param nbWorkers Number of workers to start. The caller thread is used too,
+	 * so jobs run on nbWorkers + 1 threads.
+	 *
+	 * @warning Will destroy the previous workers if there are some.
+	 */
+	void	init(uint32_t nbWorkers);
+
+//---- Free --------------------------------------------------------------------
+	/**
+	 * @brief Stop and join worker threads.
+	 */
+	void	destroy(void);
+
+//---- Jobs --------------------------------------------------------------------
+	/**
+	 * @brief Run jobs on workers and caller thread, and wait the end of all of them.
+	 *
+	 * @param nbJobs Number of jobs. Job ids go from 0 to nbJobs - 1.
+	 * @param job Function called for each job. Thread ids go from 0 (caller) to getNbThreads() - 1.
+	 *
+	 * @exception Rethrow the first exception thrown by a job, once all jobs are done.
+	 */
+	void	run(uint32_t nbJobs, const Job &job);
+
+//**** STATIC METHODS **********************************************************
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+	std::vector<std::thread>	workers;
+	std::mutex					mutex;
+	std::condition_variable		startCondition;
+	std::condition_variable		endCondition;
+	const Job					*job;
+	uint32_t					nbJobs;
+	std::atomic<uint32_t>		nextJob;
+	uint32_t					nbJobsDone;
+	uint32_t					nbActiveWorkers;
+	uint64_t					generation;
+	bool						stop;
+	// First exception of current run, rethrown by caller thread
+	std::exception_ptr			exception;
+
+//**** PRIVATE METHODS *********************************************************
+	/**
+	 * @brief Loop of a worker thread, wait and run jobs until destroy.
+	 *
+	 * @param threadId Id of the worker thread.
+	 */
+	void	workerLoop(uint32_t threadId);
+	/**
+	 * @brief Take and run jobs until there is no more job. A job that throws
+	 * still counts as done, its exception is kept for run.
+	 *
+	 * @param threadId Id of the thread running jobs.
+	 */
+	void	executeJobs(uint32_t threadId);
+};
+
+//**** FUNCTIONS ***************************************************************
+
+#endif
@@ -0,0 +1,325 @@
+#ifndef INSTANCE_BUFFER_HPP
+# define INSTANCE_BUFFER_HPP
+
+# include <engine/mesh/InstancePos.hpp>
+# include <engine/vulkan/VulkanCommandPool.hpp>
+# include <engine/vulkan/VulkanUtils.hpp>
+
+# include <vector>
+# include <cstring>
+# include <utility>
+
+/**
+ * @brief Class for per instance data of instanced draws, bound at vertex
+ * binding 1. Made to work with Vulkan.
+ */
+template<typename InstanceType>
+class InstanceBuffer
+{
+public:
+//**** PUBLIC ATTRIBUTS ********************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Default contructor of InstanceBuffer class.
+	 *
+	 * @return The default InstanceBuffer, without instances.
+	 */
+	InstanceBuffer(void)
+	{
+		this->nbInstance = 0;
+		this->buffer = NULL;
+		this->bufferMemory = NULL;
+
+		this->commandPool = NULL;
+	}
+	/**
+	 * @brief Copy constructor of InstanceBuffer class.
+	 *
+	 * @param obj The InstanceBuffer to copy.
+	 *
+	 * @return The InstanceBuffer copied from parameter, with its own buffer.
+	 */
+	InstanceBuffer(const InstanceBuffer &obj)
+	{
+		this->instances = obj.instances;
+		this->nbInstance = obj.nbInstance;
+		this->buffer = NULL;
+		this->bufferMemory = NULL;
+
+		this->commandPool = obj.commandPool;
+
+		this->upload();
+	}
+	/**
+	 * @brief Move constructor of InstanceBuffer class.
+	 *
+	 * @param obj The InstanceBuffer to move, left empty.
+	 *
+	 * @return The InstanceBuffer moved from parameter.
+	 */
+	InstanceBuffer(InstanceBuffer &&obj) noexcept
+	{
+		this->moveFrom(obj);
+	}
+	/**
+	 * @brief Constructor of InstanceBuffer class. Vector is taken by value,
+	 * pass it with std::move to avoid any copy.
+	 *
+	 * @param instances The vector of instance.
+	 *
+	 * @return The InstanceBuffer created from parameter.
+	 *
+	 * @warning You need to call createBuffer after it if you want to use it for drawing.
+	 */
+	InstanceBuffer(std::vector<InstanceType> instances)
+	{
+		this->instances = std::move(instances);
+		this->nbInstance = static_cast<uint32_t>(this->instances.size());
+		this->buffer = NULL;
+		this->bufferMemory = NULL;
+
+		this->commandPool = NULL;
+	}
+
+//---- Destructor --------------------------------------------------------------
+	/**
+	 * @brief Destructor of InstanceBuffer class.
+	 */
+	~InstanceBuffer()
+	{
+	}
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+	/**
+	 * @brief Getter of instances.
+	 *
+	 * @return A vector of instance.
+	 */
+	const std::vector<InstanceType>	&getInstances(void) const
+	{
+		return (this->instances);
+	}
+	/**
+	 * @brief Get the number of instance.
+	 *
+	 * @return Number of instance as uint32.
+	 */
+	uint32_t	getNbInstance(void) const
+	{
+		return (this->nbInstance);
+	}
+	/**
+	 * @brief Getter of instance buffer.
+	 *
+	 * @return Instance buffer.
+	 */
+	VkBuffer	getBuffer(void) const
+	{
+		return (this->buffer);
+	}
+
+//---- Setters -----------------------------------------------------------------
+	/**
+	 * @brief Replace instances, and upload them in a new buffer if buffer is
+	 * created.
+	 *
+	 * @param instances The vector of instance, pass it with std::move to avoid any copy.
+	 */
+	void	setInstances(std::vector<InstanceType> instances)
+	{
+		this->instances = std::move(instances);
+		this->nbInstance = static_cast<uint32_t>(this->instances.size());
+
+		this->upload();
+	}
+
+//---- Operators ---------------------------------------------------------------
+	/**
+	 * @brief Copy operator of InstanceBuffer class.
+	 *
+	 * @param obj The InstanceBuffer to copy.
+	 *
+	 * @return The InstanceBuffer copied from parameter.
+	 *
+	 * @warning You need to call createBuffer after it if you want to use it for drawing.
+	 */
+	InstanceBuffer	&operator=(const InstanceBuffer &obj)
+	{
+		if (this == &obj)
+			return (*this);
+
+		this->destroy();
+
+		this->instances = obj.instances;
+		this->nbInstance = obj.nbInstance;
+
+		return (*this);
+	}
+	/**
+	 * @brief Move operator of InstanceBuffer class. Current buffer is
+	 * destroyed, then buffer of obj is taken.
+	 *
+	 * @param obj The InstanceBuffer to move, left empty.
+	 *
+	 * @return The InstanceBuffer moved from parameter.
+	 */
+	InstanceBuffer	&operator=(InstanceBuffer &&obj)
+	{
+		if (this == &obj)
+			return (*this);
+
+		this->destroy();
+		this->moveFrom(obj);
+
+		return (*this);
+	}
+
+//**** PUBLIC METHODS **********************************************************
+	/**
+	 * @brief Create buffer and upload instances.
+	 *
+	 * @param commandPool The command pool for creating buffer. It will be save for next calls.
+	 */
+	void	createBuffer(VulkanCommandPool &commandPool)
+	{
+		this->destroyBuffer();
+
+		this->commandPool = &commandPool;
+
+		this->upload();
+	}
+	/**
+	 * @brief Clear allocated memory.
+	 */
+	void	destroy(void)
+	{
+		this->instances.clear();
+		this->nbInstance = 0;
+
+		this->destroyBuffer();
+	}
+	/**
+	 * @brief Clear only allocated memory for buffer. Buffer is given to
+	 * deletion queue and freed when GPU stop using it.
+	 */
+	void	destroyBuffer(void)
+	{
+		if (this->commandPool == NULL)
+			return ;
+
+		this->releaseBuffer();
+		this->commandPool = NULL;
+	}
+
+//**** STATIC METHODS **********************************************************
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+	std::vector<InstanceType>	instances;
+	uint32_t					nbInstance;
+	VkBuffer					buffer;
+	VkDeviceMemory				bufferMemory;
+//---- Copy --------------------------------------------------------------------
+	VulkanCommandPool			*commandPool;
+
+//**** PRIVATE METHODS *********************************************************
+	/**
+	 * @brief Take data and buffer of another instance buffer, and leave it empty.
+	 *
+	 * @param obj The InstanceBuffer to move.
+	 */
+	void	moveFrom(InstanceBuffer &obj)
+	{
+		this->instances = std::move(obj.instances);
+		this->nbInstance = obj.nbInstance;
+		this->buffer = obj.buffer;
+		this->bufferMemory = obj.bufferMemory;
+		this->commandPool = obj.commandPool;
+
+		obj.instances.clear();
+		obj.nbInstance = 0;
+		obj.buffer = NULL;
+		obj.bufferMemory = NULL;
+		obj.commandPool = NULL;
+	}
+	/**
+	 * @brief Give buffer to deletion queue, frames in flight can still read it.
+	 */
+	void	releaseBuffer(void)
+	{
+		VkBuffer		oldBuffer = this->buffer;
+		VkDeviceMemory	oldMemory = this->bufferMemory;
+
+		if (oldBuffer != NULL || oldMemory != NULL)
+		{
+			this->commandPool->forgetBuffer(oldBuffer);
+			this->commandPool->getDeletionQueue().push([oldBuffer, oldMemory](VkDevice device)
+			{
+				if (oldBuffer != NULL)
+					vkDestroyBuffer(device, oldBuffer, nullptr);
+				if (oldMemory != NULL)
+					vkFreeMemory(device, oldMemory, nullptr);
+			});
+		}
+
+		this->buffer = NULL;
+		this->bufferMemory = NULL;
+	}
+	/**
+	 * @brief Upload instances into a new buffer. Previous one goes to deletion
+	 * queue, so frames in flight keep reading it and the upload never waits
+	 * for them.
+	 */
+	void	upload(void)
+	{
+		if (this->commandPool == NULL)
+			return ;
+
+		// Never written in place, the buffer may still be read by gpu
+		this->releaseBuffer();
+		if (this->nbInstance == 0)
+			return ;
+
+		VkDevice			copyDevice = this->commandPool->getCopyDevice();
+		VkPhysicalDevice	copyPhysicalDevice = this->commandPool->getCopyPhysicalDevice();
+
+		VkDeviceSize	bufferSize = sizeof(InstanceType) * this->nbInstance;
+
+		createVulkanBuffer(copyDevice, copyPhysicalDevice,
+							bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+							VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+							this->buffer, this->bufferMemory);
+
+		// Create temp buffers
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingBufferMemory;
+		createVulkanBuffer(copyDevice, copyPhysicalDevice,
+							bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+							VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+							stagingBuffer, stagingBufferMemory);
+
+		// Map data to instance buffer
+		void	*data;
+		vkMapMemory(copyDevice, stagingBufferMemory, 0, bufferSize, 0, &data);
+		memcpy(data, this->instances.data(), (size_t) bufferSize);
+		vkUnmapMemory(copyDevice, stagingBufferMemory);
+
+		// Copy data form temp to final buffer
+		copyBuffer(*commandPool, stagingBuffer, this->buffer, bufferSize);
+
+		// Release temp buffer once copy is done, without waiting it
+		releaseStagingBuffer(*commandPool, stagingBuffer, stagingBufferMemory);
+	}
+};
+
+//**** FUNCTIONS ***************************************************************
+
+//**** USING *******************************************************************
+/**
+ * @brief Instance buffer of positions and scales.
+ */
+using InstanceBufferPos = InstanceBuffer<InstancePos>;
+
+#endif
@@ -0,0 +1,54 @@
+#include <engine/mesh/InstancePos.hpp>
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+
+InstancePos::InstancePos(void)
+{
+	this->pos = gm::Vec3f();
+	this->scale = 1.0f;
+}
+
+
+InstancePos::InstancePos(const InstancePos &obj)
+{
+	this->pos = obj.pos;
+	this->scale = obj.scale;
+}
+
+
+InstancePos::InstancePos(const gm::Vec3f &pos, float scale)
+{
+	this->pos = pos;
+	this->scale = scale;
+}
+
+//---- Destructor --------------------------------------------------------------
+
+InstancePos::~InstancePos()
+{
+
+}
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+
+InstancePos	&InstancePos::operator=(const InstancePos &obj)
+{
+	if (this == &obj)
+		return (*this);
+
+	this->pos = obj.pos;
+	this->scale = obj.scale;
+
+	return (*this);
+}
+
+//**** PUBLIC METHODS **********************************************************
+//**** STATIC METHODS **********************************************************
+//**** PRIVATE METHODS *********************************************************
+//**** FUNCTIONS ***************************************************************
+//**** STATIC FUNCTIONS ********************************************************
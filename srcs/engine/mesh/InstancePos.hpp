@@ -0,0 +1,81 @@
+#ifndef INSTANCE_POS_HPP
+# define INSTANCE_POS_HPP
+
+# include <defineCore.hpp>
+
+# include <cstddef>
+# include <gmath.hpp>
+
+/**
+ * @brief Class for per instance data with a position and a scale, read at
+ * vertex binding 1. Vulkan input layout is described in VertexInput.hpp.
+ */
+class InstancePos
+{
+public:
+//**** PUBLIC ATTRIBUTS ********************************************************
+	/**
+	 * @brief Position of instance, added to mesh position.
+	 */
+	gm::Vec3f	pos;
+	/**
+	 * @brief Scale of instance.
+	 */
+	float		scale;
+
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Default contructor of InstancePos class.
+	 *
+	 * @return The default InstancePos, at origin with scale 1.
+	 */
+	InstancePos(void);
+	/**
+	 * @brief Copy constructor of InstancePos class.
+	 *
+	 * @param obj The InstancePos to copy.
+	 *
+	 * @return The InstancePos copied from parameter.
+	 */
+	InstancePos(const InstancePos &obj);
+	/**
+	 * @brief Constructor of InstancePos class.
+	 *
+	 * @param pos The position of InstancePos.
+	 * @param scale The scale of InstancePos.
+	 *
+	 * @return The InstancePos create from parameter.
+	 */
+	InstancePos(const gm::Vec3f &pos, float scale);
+
+//---- Destructor --------------------------------------------------------------
+	/**
+	 * @brief Destructor of InstancePos class.
+	 */
+	~InstancePos();
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+	/**
+	 * @brief Copy operator of InstancePos class.
+	 *
+	 * @param obj The InstancePos to copy.
+	 *
+	 * @return The InstancePos copied from parameter.
+	 */
+	InstancePos	&operator=(const InstancePos &obj);
+
+//**** PUBLIC METHODS **********************************************************
+//**** STATIC METHODS **********************************************************
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+//**** PRIVATE METHODS *********************************************************
+};
+
+//**** FUNCTIONS ***************************************************************
+
+#endif
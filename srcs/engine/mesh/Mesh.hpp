@@ -3,9 +3,35 @@
 
 # include <engine/mesh/Vertex.hpp>
 # include <engine/vulkan/VulkanCommandPool.hpp>
+# include <engine/vulkan/VulkanUtils.hpp>
 
 # include <vector>
 # include <cstring>
+# include <utility>
+# include <algorithm>
+# include <stdexcept>
+
+/**
+ * @brief Struct for a range of modified vertices or indices, end excluded.
+ */
+struct MeshRange
+{
+	uint32_t	first;
+	uint32_t	end;
+};
+
+/**
+ * @brief Struct for a mapped staging buffer of partial updates, with the
+ * upload timeline value of the last copy reading it.
+ */
+struct MeshStaging
+{
+	VkBuffer		buffer;
+	VkDeviceMemory	memory;
+	VkDeviceSize	capacity;
+	void			*data;
+	uint64_t		value;
+};
 
 /**
  * @brief Class for 3D mesh. Made to work with Vulkan.
@@ -29,10 +55,7 @@ public:
 		this->scalingFactor = 1.0f;
 		this->nbVertex = 0;
 		this->nbIndex = 0;
-		this->vertexBuffer = NULL;
-		this->vertexBufferMemory = NULL;
-		this->indexBuffer = NULL;
-		this->indexBufferMemory = NULL;
+		this->resetBuffers();
 
 		this->commandPool = NULL;
 	}
@@ -52,14 +75,31 @@ public:
 		this->indices = obj.indices;
 		this->nbVertex = obj.nbVertex;
 		this->nbIndex = obj.nbIndex;
+		this->resetBuffers();
 
 		this->commandPool = obj.commandPool;
 
-		this->createVertexBuffer();
-		this->createIndexBuffer();
+		if (!obj.hasCpuData())
+			throw std::runtime_error("Can't copy a mesh without cpu data");
+
+		this->createVertexBuffer(this->getVerticesSize());
+		this->createIndexBuffer(this->getIndicesSize());
 	}
 	/**
-	 * @brief Constructor of Mesh class.
+	 * @brief Move constructor of Mesh class. Buffers are taken, nothing is
+	 * copied nor uploaded.
+	 *
+	 * @param obj The Mesh to move, left empty.
+	 *
+	 * @return The Mesh moved from parameter.
+	 */
+	Mesh(Mesh &&obj) noexcept
+	{
+		this->moveFrom(obj);
+	}
+	/**
+	 * @brief Constructor of Mesh class. Vectors are taken by value, pass them
+	 * with std::move to avoid any copy.
 	 *
 	 * @param vertices The vector of vertex.
 	 * @param indices The vector of index.
@@ -68,15 +108,16 @@ public:
 	 *
 	 * @warning You need to call createBuffers after it if you want to use it for drawing.
 	 */
-	Mesh(const std::vector<VertexType> &vertices, const std::vector<uint32_t> &indices)
+	Mesh(std::vector<VertexType> vertices, std::vector<uint32_t> indices)
 	{
 		this->position = gm::Vec3f(0.0f);
 		this->model = gm::Mat4f(1.0f);
 		this->scalingFactor = 1.0f;
-		this->vertices = vertices;
-		this->indices = indices;
+		this->vertices = std::move(vertices);
+		this->indices = std::move(indices);
 		this->nbVertex = static_cast<uint32_t>(this->vertices.size());
 		this->nbIndex = static_cast<uint32_t>(this->indices.size());
+		this->resetBuffers();
 
 		this->commandPool = NULL;
 	}
@@ -111,16 +152,16 @@ public:
 		return (this->model);
 	}
 	/**
-	 * @brief Getter of vertices.
+	 * @brief Getter of vertices. Empty after releaseCpuData.
 	 *
 	 * @return A vector of Vertex.
 	 */
-	const std::vector<Vertex>	&getVertices(void) const
+	const std::vector<VertexType>	&getVertices(void) const
 	{
 		return (this->vertices);
 	}
 	/**
-	 * @brief Getter of indices.
+	 * @brief Getter of indices. Empty after releaseCpuData.
 	 *
 	 * @return A vector of index as int32.
 	 */
@@ -164,6 +205,15 @@ public:
 	{
 		return (this->indexBuffer);
 	}
+	/**
+	 * @brief Getter of index type of index buffer, chosen when buffers are created.
+	 *
+	 * @return VK_INDEX_TYPE_UINT16 if vertices fit in 16 bits, VK_INDEX_TYPE_UINT32 else.
+	 */
+	VkIndexType	getIndexType(void) const
+	{
+		return (this->indexType);
+	}
 
 //---- Setters -----------------------------------------------------------------
 	/**
@@ -213,12 +263,17 @@ public:
 	 * @param obj The Mesh to copy.
 	 *
 	 * @return The Mesh copied from parameter.
+	 *
+	 * @exception Throw a runtime_error if obj has released its cpu data.
 	 */
 	Mesh	&operator=(const Mesh &obj)
 	{
 		if (this == &obj)
 			return (*this);
 
+		if (!obj.hasCpuData())
+			throw std::runtime_error("Can't copy a mesh without cpu data");
+
 		this->destroy();
 
 		this->position = obj.position;
@@ -231,26 +286,45 @@ public:
 
 		return (*this);
 	}
+	/**
+	 * @brief Move operator of Mesh class. Current buffers are destroyed, then
+	 * buffers of obj are taken.
+	 *
+	 * @param obj The Mesh to move, left empty.
+	 *
+	 * @return The Mesh moved from parameter.
+	 */
+	Mesh	&operator=(Mesh &&obj)
+	{
+		if (this == &obj)
+			return (*this);
+
+		this->destroy();
+		this->moveFrom(obj);
+
+		return (*this);
+	}
 
 //**** PUBLIC METHODS **********************************************************
 //---- Mesh operation ----------------------------------------------------------
 	/**
-	 * @brief Load a 3d mesh from variables.
+	 * @brief Load a 3d mesh from variables. Vectors are taken by value, pass
+	 * them with std::move to avoid any copy.
 	 *
 	 * @param vertices The vector of vertex.
 	 * @param indices The vector of index.
 	 *
 	 * @warning You need to call createBuffers after it if you want to use it for drawing.
 	 */
-	void	loadMesh(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices)
+	void	loadMesh(std::vector<VertexType> vertices, std::vector<uint32_t> indices)
 	{
 		this->destroy();
 
 		this->position = gm::Vec3f(0.0f);
 		this->model = gm::Mat4f(1.0f);
 		this->scalingFactor = 1.0f;
-		this->vertices = vertices;
-		this->indices = indices;
+		this->vertices = std::move(vertices);
+		this->indices = std::move(indices);
 		this->nbVertex = static_cast<uint32_t>(this->vertices.size());
 		this->nbIndex = static_cast<uint32_t>(this->indices.size());
 	}
@@ -261,12 +335,35 @@ public:
 	 */
 	void	createBuffers(VulkanCommandPool &commandPool)
 	{
+		if (!this->hasCpuData())
+			throw std::runtime_error("Can't create buffers of a mesh without cpu data");
+
 		this->destroyBuffers();
 
 		this->commandPool = &commandPool;
 
-		this->createVertexBuffer();
-		this->createIndexBuffer();
+		this->createVertexBuffer(this->getVerticesSize());
+		this->createIndexBuffer(this->getIndicesSize());
+	}
+	/**
+	 * @brief Free cpu copies of vertices and indices, once buffers are created.
+	 * Number of vertices and indices are kept for drawing.
+	 *
+	 * @warning The mesh can't be copied nor get its buffers created again after it.
+	 */
+	void	releaseCpuData(void)
+	{
+		std::vector<VertexType>().swap(this->vertices);
+		std::vector<uint32_t>().swap(this->indices);
+	}
+	/**
+	 * @brief Check if cpu copies of vertices and indices are present.
+	 *
+	 * @return False if releaseCpuData was called on a non empty mesh, true else.
+	 */
+	bool	hasCpuData(void) const
+	{
+		return (this->vertices.size() == this->nbVertex && this->indices.size() == this->nbIndex);
 	}
 	/**
 	 * @brief Clear allocated memory.
@@ -282,40 +379,181 @@ public:
 	}
 
 	/**
-	 * @brief Clear only allocated memory for buffers.
+	 * @brief Clear only allocated memory for buffers. Buffers are given to
+	 * deletion queue and freed when GPU stop using them.
 	 */
 	void	destroyBuffers(void)
 	{
 		if (this->commandPool == NULL)
 			return ;
 
-		VkDevice	copyDevice = this->commandPool->getCopyDevice();
+		this->destroyBuffer(this->vertexBuffer, this->vertexBufferMemory);
+		this->destroyBuffer(this->indexBuffer, this->indexBufferMemory);
+		for (MeshStaging &staging : this->stagings)
+			this->destroyBuffer(staging.buffer, staging.memory);
+
+		this->resetBuffers();
+		this->commandPool = NULL;
+	}
+
+//---- Partial update ----------------------------------------------------------
+	/**
+	 * @brief Get vertices to modify, and mark them to upload on next
+	 * updateBuffers. Mesh grows if the range go past the last vertex.
+	 *
+	 * @param first Index of first vertex to modify.
+	 * @param count Number of vertices to modify.
+	 *
+	 * @return Pointer to first vertex, valid until next edit or resize.
+	 *
+	 * @exception Throw an runtime_error if mesh has no cpu data.
+	 */
+	VertexType	*editVertices(uint32_t first, uint32_t count)
+	{
+		if (!this->hasCpuData())
+			throw std::runtime_error("Can't edit a mesh without cpu data");
+
+		if (first + count > this->nbVertex)
+		{
+			this->nbVertex = first + count;
+			this->vertices.resize(this->nbVertex);
+		}
+		addDirtyRange(this->dirtyVertices, first, first + count);
+
+		return (this->vertices.data() + first);
+	}
+	/**
+	 * @brief Get indices to modify, and mark them to upload on next
+	 * updateBuffers. Mesh grows if the range go past the last index.
+	 *
+	 * @param first Position of first index to modify.
+	 * @param count Number of indices to modify.
+	 *
+	 * @return Pointer to first index, valid until next edit or resize.
+	 *
+	 * @exception Throw an runtime_error if mesh has no cpu data.
+	 */
+	uint32_t	*editIndices(uint32_t first, uint32_t count)
+	{
+		if (!this->hasCpuData())
+			throw std::runtime_error("Can't edit a mesh without cpu data");
+
+		if (first + count > this->nbIndex)
+		{
+			this->nbIndex = first + count;
+			this->indices.resize(this->nbIndex);
+		}
+		addDirtyRange(this->dirtyIndices, first, first + count);
+
+		return (this->indices.data() + first);
+	}
+	/**
+	 * @brief Change number of vertices and indices. New ones are default
+	 * values, to set with editVertices and editIndices.
+	 *
+	 * @param nbVertex New number of vertices.
+	 * @param nbIndex New number of indices.
+	 *
+	 * @exception Throw an runtime_error if mesh has no cpu data.
+	 */
+	void	resize(uint32_t nbVertex, uint32_t nbIndex)
+	{
+		if (!this->hasCpuData())
+			throw std::runtime_error("Can't resize a mesh without cpu data");
+
+		if (nbVertex > this->nbVertex)
+			addDirtyRange(this->dirtyVertices, this->nbVertex, nbVertex);
+		if (nbIndex > this->nbIndex)
+			addDirtyRange(this->dirtyIndices, this->nbIndex, nbIndex);
+
+		this->nbVertex = nbVertex;
+		this->nbIndex = nbIndex;
+		this->vertices.resize(nbVertex);
+		this->indices.resize(nbIndex);
+	}
+	/**
+	 * @brief Upload modified ranges to buffers, in one copy per buffer through
+	 * staging buffers kept between calls. Copies are never waited on CPU, a
+	 * staging buffer still read by one is left alone and another is used. A
+	 * buffer too small is reallocated with twice its capacity and fully
+	 * uploaded. Nothing is done before createBuffers. Buffers are written in
+	 * place, the copy is ordered on GPU after reads of frames already
+	 * submitted, see VulkanCommandPool::acquireBuffer.
+	 */
+	void	updateBuffers(void)
+	{
+		if (this->commandPool == NULL)
+			return ;
+
+		// Index type change with vertex count, so it is a full upload too
+		VkIndexType	wantedIndexType = this->getWantedIndexType();
 
-		// Free vertex buffer and memory
-		if (this->vertexBuffer != NULL)
+		if (this->getVerticesSize() > this->vertexCapacity)
 		{
-			vkDestroyBuffer(copyDevice, this->vertexBuffer, nullptr);
-			this->vertexBuffer = NULL;
+			this->destroyBuffer(this->vertexBuffer, this->vertexBufferMemory);
+			this->createVertexBuffer(std::max(this->getVerticesSize(), this->vertexCapacity * 2));
+			this->dirtyVertices.clear();
 		}
-		if (this->vertexBufferMemory != NULL)
+		if (wantedIndexType != this->indexType
+			|| this->getIndicesSize() > this->indexCapacity)
 		{
-			vkFreeMemory(copyDevice, this->vertexBufferMemory, nullptr);
-			this->vertexBufferMemory = NULL;
+			VkDeviceSize	capacity = this->indexCapacity * 2;
+
+			this->destroyBuffer(this->indexBuffer, this->indexBufferMemory);
+			this->createIndexBuffer(std::max(this->getIndicesSize(), capacity));
+			this->dirtyIndices.clear();
 		}
 
-		// Free index buffer and memory
-		if (this->indexBuffer != NULL)
+		// Ranges past the end were cut by resize, they are no more drawn
+		clampDirtyRanges(this->dirtyVertices, this->nbVertex);
+		clampDirtyRanges(this->dirtyIndices, this->nbIndex);
+
+		VkDeviceSize	verticesSize = 0;
+		VkDeviceSize	indicesSize = 0;
+		for (const MeshRange &range : this->dirtyVertices)
+			verticesSize += (range.end - range.first) * sizeof(VertexType);
+		for (const MeshRange &range : this->dirtyIndices)
+			indicesSize += (range.end - range.first) * this->getIndexSize();
+
+		if (verticesSize + indicesSize == 0)
+			return ;
+
+		MeshStaging	&staging = this->getStaging(verticesSize + indicesSize);
+
+		// Pack modified ranges in staging, then copy each to its place
+		std::vector<VkBufferCopy>	regions;
+		char						*stagingData = static_cast<char *>(staging.data);
+		VkDeviceSize				offset = 0;
+
+		for (const MeshRange &range : this->dirtyVertices)
 		{
-			vkDestroyBuffer(copyDevice, this->indexBuffer, nullptr);
-			this->indexBuffer = NULL;
+			VkBufferCopy	region{};
+			region.srcOffset = offset;
+			region.dstOffset = range.first * sizeof(VertexType);
+			region.size = (range.end - range.first) * sizeof(VertexType);
+			memcpy(stagingData + offset, &this->vertices[range.first], region.size);
+			regions.push_back(region);
+			offset += region.size;
 		}
-		if (this->indexBufferMemory != NULL)
+		if (!regions.empty())
+			staging.value = copyBufferRegions(*this->commandPool, staging.buffer, this->vertexBuffer, regions);
+
+		regions.clear();
+		for (const MeshRange &range : this->dirtyIndices)
 		{
-			vkFreeMemory(copyDevice, this->indexBufferMemory, nullptr);
-			this->indexBufferMemory = NULL;
+			VkBufferCopy	region{};
+			region.srcOffset = offset;
+			region.dstOffset = range.first * this->getIndexSize();
+			region.size = (range.end - range.first) * this->getIndexSize();
+			this->writeIndices(stagingData + offset, range.first, range.end);
+			regions.push_back(region);
+			offset += region.size;
 		}
+		if (!regions.empty())
+			staging.value = copyBufferRegions(*this->commandPool, staging.buffer, this->indexBuffer, regions);
 
-		this->commandPool = NULL;
+		this->dirtyVertices.clear();
+		this->dirtyIndices.clear();
 	}
 
 //---- Geometry operation ------------------------------------------------------
@@ -367,93 +605,176 @@ private:
 	uint32_t				nbIndex;
 	VkBuffer				vertexBuffer, indexBuffer;
 	VkDeviceMemory			vertexBufferMemory, indexBufferMemory;
+	VkDeviceSize			vertexCapacity, indexCapacity;
+	VkIndexType				indexType;
+	// Kept mapped for partial updates, created on first one
+	std::vector<MeshStaging>	stagings;
+	std::vector<MeshRange>	dirtyVertices, dirtyIndices;
 //---- Copy --------------------------------------------------------------------
 	VulkanCommandPool		*commandPool;
 
 //**** PRIVATE METHODS *********************************************************
 	/**
-	 * @brief Create vertex buffer and vertex buffer memory.
+	 * @brief Take data and buffers of another mesh, and leave it empty.
+	 * Current buffers must be already destroyed.
+	 *
+	 * @param obj The Mesh to move.
 	 */
-	void	createVertexBuffer(void)
+	void	moveFrom(Mesh &obj)
 	{
-		if (this->commandPool == NULL)
-			return ;
-
-		VkDevice			copyDevice = this->commandPool->getCopyDevice();
-		VkPhysicalDevice	copyPhysicalDevice = this->commandPool->getCopyPhysicalDevice();
-
-		VkDeviceSize	bufferSize = sizeof(this->vertices[0]) * this->nbVertex;
-
-		// Create temp buffers
-		VkBuffer stagingBuffer;
-		VkDeviceMemory stagingBufferMemory;
-		createVulkanBuffer(copyDevice, copyPhysicalDevice,
-							bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-							VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-							stagingBuffer, stagingBufferMemory);
-
-		// Map data to vertex buffer
-		void	*data;
-		vkMapMemory(copyDevice, stagingBufferMemory, 0, bufferSize, 0, &data);
-		memcpy(data, this->vertices.data(), (size_t) bufferSize);
-		vkUnmapMemory(copyDevice, stagingBufferMemory);
+		this->position = obj.position;
+		this->model = obj.model;
+		this->scalingFactor = obj.scalingFactor;
+		this->vertices = std::move(obj.vertices);
+		this->indices = std::move(obj.indices);
+		this->nbVertex = obj.nbVertex;
+		this->nbIndex = obj.nbIndex;
+		this->vertexBuffer = obj.vertexBuffer;
+		this->vertexBufferMemory = obj.vertexBufferMemory;
+		this->indexBuffer = obj.indexBuffer;
+		this->indexBufferMemory = obj.indexBufferMemory;
+		this->vertexCapacity = obj.vertexCapacity;
+		this->indexCapacity = obj.indexCapacity;
+		this->indexType = obj.indexType;
+		this->stagings = std::move(obj.stagings);
+		this->dirtyVertices = std::move(obj.dirtyVertices);
+		this->dirtyIndices = std::move(obj.dirtyIndices);
+		this->commandPool = obj.commandPool;
 
-		// Create final buffer
-		createVulkanBuffer(copyDevice, copyPhysicalDevice,
-							bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-							VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-							this->vertexBuffer, this->vertexBufferMemory);
+		obj.vertices.clear();
+		obj.indices.clear();
+		obj.nbVertex = 0;
+		obj.nbIndex = 0;
+		obj.resetBuffers();
+		obj.commandPool = NULL;
+	}
+	/**
+	 * @brief Set buffers handles to NULL and forget modified ranges, without
+	 * freeing anything.
+	 */
+	void	resetBuffers(void)
+	{
+		this->vertexBuffer = NULL;
+		this->vertexBufferMemory = NULL;
+		this->indexBuffer = NULL;
+		this->indexBufferMemory = NULL;
+		this->vertexCapacity = 0;
+		this->indexCapacity = 0;
+		this->indexType = VK_INDEX_TYPE_UINT32;
+		this->stagings.clear();
+		this->dirtyVertices.clear();
+		this->dirtyIndices.clear();
+	}
+	/**
+	 * @brief Give a buffer to deletion queue, frames in flight can still
+	 * read it. Handles are set to NULL.
+	 *
+	 * @param buffer Buffer to destroy.
+	 * @param memory Memory of buffer.
+	 */
+	void	destroyBuffer(VkBuffer &buffer, VkDeviceMemory &memory)
+	{
+		if (buffer == NULL && memory == NULL)
+			return ;
 
-		// Copy data form temp to final buffer
-		copyBuffer(*commandPool, stagingBuffer, this->vertexBuffer, bufferSize);
+		VkBuffer		oldBuffer = buffer;
+		VkDeviceMemory	oldMemory = memory;
 
-		// Release temp buffer
-		vkDestroyBuffer(copyDevice, stagingBuffer, nullptr);
-		vkFreeMemory(copyDevice, stagingBufferMemory, nullptr);
+		this->commandPool->forgetBuffer(oldBuffer);
+		this->commandPool->getDeletionQueue().push([oldBuffer, oldMemory](VkDevice device)
+		{
+			if (oldBuffer != NULL)
+				vkDestroyBuffer(device, oldBuffer, nullptr);
+			if (oldMemory != NULL)
+				vkFreeMemory(device, oldMemory, nullptr);
+		});
+
+		buffer = NULL;
+		memory = NULL;
 	}
 	/**
-	 * @brief Create index buffer and index buffer memory.
+	 * @brief Get a staging buffer that no copy in flight read, of at least
+	 * size bytes. A free one too small is grown geometrically, if all are
+	 * read a new one is created, so CPU never waits GPU.
+	 *
+	 * @param size Minimal size in bytes.
+	 *
+	 * @return The staging buffer, valid until next call.
 	 */
-	void	createIndexBuffer(void)
+	MeshStaging	&getStaging(VkDeviceSize size)
 	{
-		if (this->commandPool == NULL)
-			return ;
+		uint64_t	completedValue = this->commandPool->getUploadTimeline().getCompletedValue();
+		MeshStaging	*freeStaging = NULL;
+
+		for (MeshStaging &staging : this->stagings)
+		{
+			if (staging.value > completedValue)
+				continue ;
+			if (staging.capacity >= size)
+				return (staging);
+			freeStaging = &staging;
+		}
+
+		if (freeStaging == NULL)
+		{
+			this->stagings.push_back({NULL, NULL, 0, NULL, 0});
+			freeStaging = &this->stagings.back();
+		}
 
 		VkDevice			copyDevice = this->commandPool->getCopyDevice();
 		VkPhysicalDevice	copyPhysicalDevice = this->commandPool->getCopyPhysicalDevice();
 
-		VkDeviceSize bufferSize = sizeof(this->indices[0]) * this->nbIndex;
+		// Its copies are done, deletion queue only delay destruction like others
+		this->destroyBuffer(freeStaging->buffer, freeStaging->memory);
 
-		// Create temp buffers
-		VkBuffer stagingBuffer;
-		VkDeviceMemory stagingBufferMemory;
+		freeStaging->capacity = std::max(size, freeStaging->capacity * 2);
 		createVulkanBuffer(copyDevice, copyPhysicalDevice,
-							bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+							freeStaging->capacity, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 							VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-							stagingBuffer, stagingBufferMemory);
+							freeStaging->buffer, freeStaging->memory);
+		vkMapMemory(copyDevice, freeStaging->memory, 0, freeStaging->capacity, 0, &freeStaging->data);
 
-		// Map data to vertex buffer
-		void* data;
-		vkMapMemory(copyDevice, stagingBufferMemory, 0, bufferSize, 0, &data);
-		memcpy(data, this->indices.data(), (size_t) bufferSize);
-		vkUnmapMemory(copyDevice, stagingBufferMemory);
-
-		// Create final buffer
-		createVulkanBuffer(copyDevice, copyPhysicalDevice,
-							bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-							VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, this->indexBuffer, this->indexBufferMemory);
-
-		// Copy data form temp to final buffer
-		copyBuffer(*commandPool, stagingBuffer, this->indexBuffer, bufferSize);
-
-		// Release temp buffer
-		vkDestroyBuffer(copyDevice, stagingBuffer, nullptr);
-		vkFreeMemory(copyDevice, stagingBufferMemory, nullptr);
+		return (*freeStaging);
 	}
 	/**
-	 * @brief Update vertex buffer.
+	 * @brief Get size of vertices in vertex buffer.
+	 *
+	 * @return Size in bytes.
 	 */
-	void	updateVertexBuffer(void)
+	VkDeviceSize	getVerticesSize(void) const
+	{
+		return (sizeof(VertexType) * this->nbVertex);
+	}
+	/**
+	 * @brief Get size of indices in index buffer, with index type for current
+	 * number of vertices.
+	 *
+	 * @return Size in bytes.
+	 */
+	VkDeviceSize	getIndicesSize(void) const
+	{
+		if (this->getWantedIndexType() == VK_INDEX_TYPE_UINT16)
+			return (sizeof(uint16_t) * this->nbIndex);
+		return (sizeof(uint32_t) * this->nbIndex);
+	}
+	/**
+	 * @brief Get index type for current number of vertices. Index 0xFFFF is
+	 * kept unused, it's the primitive restart value.
+	 *
+	 * @return VK_INDEX_TYPE_UINT16 if vertices fit in 16 bits, VK_INDEX_TYPE_UINT32 else.
+	 */
+	VkIndexType	getWantedIndexType(void) const
+	{
+		if (this->nbVertex <= UINT16_MAX)
+			return (VK_INDEX_TYPE_UINT16);
+		return (VK_INDEX_TYPE_UINT32);
+	}
+	/**
+	 * @brief Create vertex buffer and vertex buffer memory, and upload vertices.
+	 *
+	 * @param capacity Size of buffer, at least size of vertices.
+	 */
+	void	createVertexBuffer(VkDeviceSize capacity)
 	{
 		if (this->commandPool == NULL)
 			return ;
@@ -461,13 +782,23 @@ private:
 		VkDevice			copyDevice = this->commandPool->getCopyDevice();
 		VkPhysicalDevice	copyPhysicalDevice = this->commandPool->getCopyPhysicalDevice();
 
-		VkDeviceSize	bufferSize = sizeof(this->vertices[0]) * this->nbVertex;
+		VkDeviceSize	bufferSize = this->getVerticesSize();
+
+		// Create final buffer
+		this->vertexCapacity = capacity;
+		createVulkanBuffer(copyDevice, copyPhysicalDevice,
+							capacity, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+							VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+							this->vertexBuffer, this->vertexBufferMemory);
+
+		if (bufferSize == 0)
+			return ;
 
 		// Create temp buffers
 		VkBuffer stagingBuffer;
 		VkDeviceMemory stagingBufferMemory;
 		createVulkanBuffer(copyDevice, copyPhysicalDevice,
-							bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+							bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 							VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
 							stagingBuffer, stagingBufferMemory);
 
@@ -480,14 +811,16 @@ private:
 		// Copy data form temp to final buffer
 		copyBuffer(*commandPool, stagingBuffer, this->vertexBuffer, bufferSize);
 
-		// Release temp buffer
-		vkDestroyBuffer(copyDevice, stagingBuffer, nullptr);
-		vkFreeMemory(copyDevice, stagingBufferMemory, nullptr);
+		// Release temp buffer once copy is done, without waiting it
+		releaseStagingBuffer(*commandPool, stagingBuffer, stagingBufferMemory);
 	}
 	/**
-	 * @brief Update index buffer.
+	 * @brief Create index buffer and index buffer memory, and upload indices.
+	 * Index type is chosen from number of vertices.
+	 *
+	 * @param capacity Size of buffer, at least size of indices.
 	 */
-	void	updateIndexBuffer(void)
+	void	createIndexBuffer(VkDeviceSize capacity)
 	{
 		if (this->commandPool == NULL)
 			return ;
@@ -495,7 +828,17 @@ private:
 		VkDevice			copyDevice = this->commandPool->getCopyDevice();
 		VkPhysicalDevice	copyPhysicalDevice = this->commandPool->getCopyPhysicalDevice();
 
-		VkDeviceSize bufferSize = sizeof(this->indices[0]) * this->nbIndex;
+		this->indexType = this->getWantedIndexType();
+		VkDeviceSize bufferSize = this->getIndicesSize();
+
+		// Create final buffer
+		this->indexCapacity = capacity;
+		createVulkanBuffer(copyDevice, copyPhysicalDevice,
+							capacity, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+							VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, this->indexBuffer, this->indexBufferMemory);
+
+		if (bufferSize == 0)
+			return ;
 
 		// Create temp buffers
 		VkBuffer stagingBuffer;
@@ -508,15 +851,92 @@ private:
 		// Map data to vertex buffer
 		void* data;
 		vkMapMemory(copyDevice, stagingBufferMemory, 0, bufferSize, 0, &data);
-		memcpy(data, this->indices.data(), (size_t) bufferSize);
+		this->writeIndices(data, 0, this->nbIndex);
 		vkUnmapMemory(copyDevice, stagingBufferMemory);
 
 		// Copy data form temp to final buffer
 		copyBuffer(*commandPool, stagingBuffer, this->indexBuffer, bufferSize);
 
-		// Release temp buffer
-		vkDestroyBuffer(copyDevice, stagingBuffer, nullptr);
-		vkFreeMemory(copyDevice, stagingBufferMemory, nullptr);
+		// Release temp buffer once copy is done, without waiting it
+		releaseStagingBuffer(*commandPool, stagingBuffer, stagingBufferMemory);
+	}
+	/**
+	 * @brief Get the size of one index in index buffer.
+	 *
+	 * @return Size in bytes.
+	 */
+	VkDeviceSize	getIndexSize(void) const
+	{
+		if (this->indexType == VK_INDEX_TYPE_UINT16)
+			return (sizeof(uint16_t));
+		return (sizeof(uint32_t));
+	}
+	/**
+	 * @brief Write a range of indices with index type into mapped memory.
+	 *
+	 * @param data Mapped memory, at least getIndexSize() * (end - first) bytes.
+	 * @param first First index to write.
+	 * @param end Index after the last to write.
+	 */
+	void	writeIndices(void *data, uint32_t first, uint32_t end) const
+	{
+		if (this->indexType == VK_INDEX_TYPE_UINT32)
+		{
+			memcpy(data, this->indices.data() + first, sizeof(uint32_t) * (end - first));
+			return ;
+		}
+
+		uint16_t	*dst = static_cast<uint16_t *>(data);
+		for (uint32_t i = first; i < end; i++)
+			dst[i - first] = static_cast<uint16_t>(this->indices[i]);
+	}
+	/**
+	 * @brief Add a modified range, merged with the ones it touches. Past
+	 * MESH_MAX_DIRTY_RANGES ranges, all are merged in one.
+	 *
+	 * @param ranges Modified ranges, sorted and disjoint.
+	 * @param first First modified element.
+	 * @param end Element after the last modified.
+	 */
+	static void	addDirtyRange(std::vector<MeshRange> &ranges, uint32_t first, uint32_t end)
+	{
+		if (first >= end)
+			return ;
+
+		// Skip ranges ending before the new one
+		size_t	i = 0;
+		while (i < ranges.size() && ranges[i].end < first)
+			i++;
+
+		// Absorb ranges touching the new one
+		size_t	j = i;
+		while (j < ranges.size() && ranges[j].first <= end)
+		{
+			first = std::min(first, ranges[j].first);
+			end = std::max(end, ranges[j].end);
+			j++;
+		}
+		ranges.erase(ranges.begin() + i, ranges.begin() + j);
+		ranges.insert(ranges.begin() + i, MeshRange{first, end});
+
+		if (ranges.size() > MESH_MAX_DIRTY_RANGES)
+		{
+			MeshRange	all = {ranges.front().first, ranges.back().end};
+			ranges.assign(1, all);
+		}
+	}
+	/**
+	 * @brief Cut modified ranges to a number of elements.
+	 *
+	 * @param ranges Modified ranges, sorted and disjoint.
+	 * @param size Number of elements.
+	 */
+	static void	clampDirtyRanges(std::vector<MeshRange> &ranges, uint32_t size)
+	{
+		while (!ranges.empty() && ranges.back().first >= size)
+			ranges.pop_back();
+		if (!ranges.empty() && ranges.back().end > size)
+			ranges.back().end = size;
 	}
 };
 
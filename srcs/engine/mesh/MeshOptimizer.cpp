@@ -0,0 +1,345 @@
+#include <engine/mesh/MeshOptimizer.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+//**** STATIC VARIABLES ********************************************************
+
+// Forsyth scoring, values from the original paper
+static const float	cacheDecayPower = 1.5f;
+static const float	lastTriangleScore = 0.75f;
+static const float	valenceBoostScale = 2.0f;
+static const float	valenceBoostPower = 0.5f;
+
+//**** STATIC STRUCTS **********************************************************
+
+/**
+ * @brief Struct for a cluster of consecutive triangles.
+ */
+struct TriangleCluster
+{
+	uint32_t	start;
+	uint32_t	end;
+	float		sortKey;
+};
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+
+static float	getVertexScore(int cachePosition, uint32_t nbRemaining, uint32_t cacheSize);
+static float	getClusterSortKey(
+					const std::vector<uint32_t> &indices,
+					const std::vector<gm::Vec3f> &positions,
+					const TriangleCluster &cluster,
+					const gm::Vec3f &meshCenter);
+
+//**** FUNCTIONS ***************************************************************
+
+float	computeAcmr(const std::vector<uint32_t> &indices, uint32_t nbVertex, uint32_t cacheSize)
+{
+	size_t	nbTriangle = indices.size() / 3;
+	if (nbTriangle == 0)
+		return (0.0f);
+
+	// A vertex is in cache if less than cacheSize misses happened since its own
+	std::vector<uint32_t>	cacheTimes(nbVertex, 0);
+	uint32_t				time = cacheSize + 1;
+	uint32_t				nbMiss = 0;
+
+	for (uint32_t index : indices)
+	{
+		if (time - cacheTimes[index] > cacheSize)
+		{
+			cacheTimes[index] = time++;
+			nbMiss++;
+		}
+	}
+
+	return (static_cast<float>(nbMiss) / static_cast<float>(nbTriangle));
+}
+
+
+void	optimizeVertexCache(std::vector<uint32_t> &indices, uint32_t nbVertex, uint32_t cacheSize)
+{
+	uint32_t	nbTriangle = static_cast<uint32_t>(indices.size() / 3);
+	if (nbTriangle == 0)
+		return ;
+
+	// Triangles of each vertex, emitted ones are swapped out of the list
+	std::vector<uint32_t>	nbRemaining(nbVertex, 0);
+	std::vector<uint32_t>	offsets(nbVertex + 1, 0);
+	std::vector<uint32_t>	adjacency(nbTriangle * 3);
+
+	for (uint32_t i = 0; i < nbTriangle * 3; i++)
+		nbRemaining[indices[i]]++;
+	for (uint32_t i = 0; i < nbVertex; i++)
+		offsets[i + 1] = offsets[i] + nbRemaining[i];
+
+	std::vector<uint32_t>	fill(offsets.begin(), offsets.end() - 1);
+	for (uint32_t i = 0; i < nbTriangle * 3; i++)
+		adjacency[fill[indices[i]]++] = i / 3;
+
+	std::vector<int>		cachePositions(nbVertex, -1);
+	std::vector<float>		vertexScores(nbVertex);
+	std::vector<float>		triangleScores(nbTriangle);
+	std::vector<bool>		emitted(nbTriangle, false);
+
+	for (uint32_t i = 0; i < nbVertex; i++)
+		vertexScores[i] = getVertexScore(-1, nbRemaining[i], cacheSize);
+
+	int		bestTriangle = -1;
+	float	bestScore = -1.0f;
+	for (uint32_t i = 0; i < nbTriangle; i++)
+	{
+		triangleScores[i] = vertexScores[indices[i * 3]] + vertexScores[indices[i * 3 + 1]]
+							+ vertexScores[indices[i * 3 + 2]];
+		if (triangleScores[i] > bestScore)
+		{
+			bestScore = triangleScores[i];
+			bestTriangle = i;
+		}
+	}
+
+	std::vector<uint32_t>	cache;
+	std::vector<uint32_t>	newCache;
+	std::vector<uint32_t>	result;
+	uint32_t				cursor = 0;
+
+	cache.reserve(cacheSize + 3);
+	newCache.reserve(cacheSize + 3);
+	result.reserve(indices.size());
+
+	while (result.size() < indices.size())
+	{
+		// No triangle touch the cache, take next one in input order
+		if (bestTriangle < 0)
+		{
+			while (emitted[cursor])
+				cursor++;
+			bestTriangle = cursor;
+		}
+
+		const uint32_t	*triangle = &indices[bestTriangle * 3];
+		emitted[bestTriangle] = true;
+		result.insert(result.end(), triangle, triangle + 3);
+
+		// Remove triangle from its vertices lists
+		for (int i = 0; i < 3; i++)
+		{
+			uint32_t	vertex = triangle[i];
+			uint32_t	*list = &adjacency[offsets[vertex]];
+			uint32_t	nb = nbRemaining[vertex];
+
+			for (uint32_t j = 0; j < nb; j++)
+			{
+				if (list[j] == static_cast<uint32_t>(bestTriangle))
+				{
+					std::swap(list[j], list[nb - 1]);
+					nbRemaining[vertex]--;
+					break ;
+				}
+			}
+		}
+
+		// Triangle vertices go to cache front, others are pushed back
+		newCache.clear();
+		for (int i = 0; i < 3; i++)
+		{
+			if (std::find(newCache.begin(), newCache.end(), triangle[i]) == newCache.end())
+				newCache.push_back(triangle[i]);
+		}
+		for (uint32_t vertex : cache)
+		{
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+				newCache.push_back(vertex);
+		}
+
+		for (size_t i = 0; i < newCache.size(); i++)
+		{
+			uint32_t	vertex = newCache[i];
+
+			cachePositions[vertex] = i < cacheSize ? static_cast<int>(i) : -1;
+			vertexScores[vertex] = getVertexScore(cachePositions[vertex], nbRemaining[vertex], cacheSize);
+		}
+
+		// Only triangles of changed vertices change score, next best is one of them
+		bestTriangle = -1;
+		bestScore = -1.0f;
+		for (uint32_t vertex : newCache)
+		{
+			const uint32_t	*list = &adjacency[offsets[vertex]];
+
+			for (uint32_t j = 0; j < nbRemaining[vertex]; j++)
+			{
+				uint32_t	id = list[j];
+
+				triangleScores[id] = vertexScores[indices[id * 3]] + vertexScores[indices[id * 3 + 1]]
+									+ vertexScores[indices[id * 3 + 2]];
+				if (triangleScores[id] > bestScore)
+				{
+					bestScore = triangleScores[id];
+					bestTriangle = id;
+				}
+			}
+		}
+
+		if (newCache.size() > cacheSize)
+			newCache.resize(cacheSize);
+		cache.swap(newCache);
+	}
+
+	indices.swap(result);
+}
+
+
+void	optimizeOverdraw(std::vector<uint32_t> &indices, const std::vector<gm::Vec3f> &positions, uint32_t cacheSize)
+{
+	uint32_t	nbTriangle = static_cast<uint32_t>(indices.size() / 3);
+	if (nbTriangle == 0)
+		return ;
+
+	// Split where the 3 vertices of a triangle miss the cache, same simulation as acmr
+	std::vector<TriangleCluster>	clusters;
+	std::vector<uint32_t>			cacheTimes(positions.size(), 0);
+	uint32_t						time = cacheSize + 1;
+	uint32_t						start = 0;
+
+	for (uint32_t i = 0; i < nbTriangle; i++)
+	{
+		int	nbMiss = 0;
+
+		for (int j = 0; j < 3; j++)
+		{
+			uint32_t	index = indices[i * 3 + j];
+
+			if (time - cacheTimes[index] > cacheSize)
+			{
+				cacheTimes[index] = time++;
+				nbMiss++;
+			}
+		}
+
+		if (nbMiss == 3 && i - start >= MESH_OPTIMIZER_CLUSTER_SIZE)
+		{
+			clusters.push_back({start, i, 0.0f});
+			start = i;
+		}
+	}
+	clusters.push_back({start, nbTriangle, 0.0f});
+
+	if (clusters.size() == 1)
+		return ;
+
+	gm::Vec3f	center(0.0f);
+	for (uint32_t index : indices)
+	{
+		center.x += positions[index].x;
+		center.y += positions[index].y;
+		center.z += positions[index].z;
+	}
+	center.x /= indices.size();
+	center.y /= indices.size();
+	center.z /= indices.size();
+
+	for (TriangleCluster &cluster : clusters)
+		cluster.sortKey = getClusterSortKey(indices, positions, cluster, center);
+
+	// Outer clusters first, they hide inner ones
+	std::stable_sort(clusters.begin(), clusters.end(),
+		[](const TriangleCluster &a, const TriangleCluster &b)
+		{
+			return (a.sortKey > b.sortKey);
+		});
+
+	std::vector<uint32_t>	result;
+	result.reserve(indices.size());
+	for (const TriangleCluster &cluster : clusters)
+		result.insert(result.end(), indices.begin() + cluster.start * 3, indices.begin() + cluster.end * 3);
+
+	indices.swap(result);
+}
+
+
+uint32_t	optimizeVertexFetch(std::vector<uint32_t> &indices, uint32_t nbVertex, std::vector<uint32_t> &remap)
+{
+	uint32_t	nbUsed = 0;
+
+	remap.assign(nbVertex, UINT32_MAX);
+
+	// Vertices are stored in first use order, fetched almost linearly
+	for (uint32_t &index : indices)
+	{
+		if (remap[index] == UINT32_MAX)
+			remap[index] = nbUsed++;
+		index = remap[index];
+	}
+
+	return (nbUsed);
+}
+
+//**** STATIC FUNCTIONS ********************************************************
+
+static float	getVertexScore(int cachePosition, uint32_t nbRemaining, uint32_t cacheSize)
+{
+	// Vertex without triangle left is never wanted
+	if (nbRemaining == 0)
+		return (-1.0f);
+
+	float	score = 0.0f;
+
+	if (cachePosition >= 0)
+	{
+		// Last triangle vertices have a fixed score, so it's not reused directly
+		if (cachePosition < 3)
+			score = lastTriangleScore;
+		else
+		{
+			float	scaler = 1.0f / static_cast<float>(cacheSize - 3);
+			score = std::pow(1.0f - (cachePosition - 3) * scaler, cacheDecayPower);
+		}
+	}
+
+	// Boost vertices with few triangles left, to finish them and avoid isolated ones
+	score += valenceBoostScale * std::pow(static_cast<float>(nbRemaining), -valenceBoostPower);
+
+	return (score);
+}
+
+
+static float	getClusterSortKey(
+					const std::vector<uint32_t> &indices,
+					const std::vector<gm::Vec3f> &positions,
+					const TriangleCluster &cluster,
+					const gm::Vec3f &meshCenter)
+{
+	gm::Vec3f	center(0.0f);
+	gm::Vec3f	normal(0.0f);
+
+	for (uint32_t i = cluster.start; i < cluster.end; i++)
+	{
+		const gm::Vec3f	&a = positions[indices[i * 3]];
+		const gm::Vec3f	&b = positions[indices[i * 3 + 1]];
+		const gm::Vec3f	&c = positions[indices[i * 3 + 2]];
+
+		center.x += a.x + b.x + c.x;
+		center.y += a.y + b.y + c.y;
+		center.z += a.z + b.z + c.z;
+
+		// Cross product length is area weighted
+		gm::Vec3f	ab(b.x - a.x, b.y - a.y, b.z - a.z);
+		gm::Vec3f	ac(c.x - a.x, c.y - a.y, c.z - a.z);
+		normal.x += ab.y * ac.z - ab.z * ac.y;
+		normal.y += ab.z * ac.x - ab.x * ac.z;
+		normal.z += ab.x * ac.y - ab.y * ac.x;
+	}
+
+	float	nbPoints = static_cast<float>((cluster.end - cluster.start) * 3);
+	center.x = center.x / nbPoints - meshCenter.x;
+	center.y = center.y / nbPoints - meshCenter.y;
+	center.z = center.z / nbPoints - meshCenter.z;
+
+	float	length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+	if (length == 0.0f)
+		return (0.0f);
+
+	return ((center.x * normal.x + center.y * normal.y + center.z * normal.z) / length);
+}
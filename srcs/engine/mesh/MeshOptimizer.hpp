@@ -0,0 +1,109 @@
+#ifndef MESH_OPTIMIZER_HPP
+# define MESH_OPTIMIZER_HPP
+
+# include <defineCore.hpp>
+
+# include <gmath.hpp>
+# include <vector>
+# include <cstdint>
+
+/**
+ * @brief Struct for mesh optimization result.
+ */
+struct MeshOptimizerStats
+{
+	// Average vertex shader invocations per triangle, 0.5 is best, 3 is worst
+	float	acmrBefore;
+	float	acmrAfter;
+};
+
+/**
+ * @brief Compute the average cache miss ratio of indices, with a fifo cache.
+ *
+ * @param indices Triangle indices.
+ * @param nbVertex Number of vertices.
+ * @param cacheSize Number of vertices in cache.
+ *
+ * @return Number of cache misses per triangle, 0 if there is no triangle.
+ */
+float	computeAcmr(const std::vector<uint32_t> &indices, uint32_t nbVertex,
+					uint32_t cacheSize = MESH_OPTIMIZER_CACHE_SIZE);
+/**
+ * @brief Reorder triangles for post transform vertex cache, with Forsyth
+ * linear-speed algorithm.
+ *
+ * @param indices Triangle indices to reorder.
+ * @param nbVertex Number of vertices.
+ * @param cacheSize Number of vertices in cache.
+ */
+void	optimizeVertexCache(std::vector<uint32_t> &indices, uint32_t nbVertex,
+							uint32_t cacheSize = MESH_OPTIMIZER_CACHE_SIZE);
+/**
+ * @brief Reorder triangle clusters so the ones facing out of the mesh are
+ * drawn first. Clusters start where cache is cold, so cache order is kept.
+ *
+ * @param indices Triangle indices to reorder, already optimized for cache.
+ * @param positions Position of each vertex.
+ * @param cacheSize Number of vertices in cache.
+ */
+void	optimizeOverdraw(std::vector<uint32_t> &indices, const std::vector<gm::Vec3f> &positions,
+							uint32_t cacheSize = MESH_OPTIMIZER_CACHE_SIZE);
+/**
+ * @brief Compute a vertex remap in first use order, for vertex fetch locality.
+ * Indices are remapped.
+ *
+ * @param indices Triangle indices to remap.
+ * @param nbVertex Number of vertices.
+ * @param remap Filled with new index of each vertex, UINT32_MAX if unused.
+ *
+ * @return Number of used vertices.
+ */
+uint32_t	optimizeVertexFetch(std::vector<uint32_t> &indices, uint32_t nbVertex,
+								std::vector<uint32_t> &remap);
+
+/**
+ * @brief Optimize a mesh : triangles for vertex cache, then for overdraw
+ * if asked, then vertices for fetch. Unused vertices are removed.
+ *
+ * @param vertices Vertices to reorder, need a pos attribut.
+ * @param indices Triangle indices to reorder.
+ * @param overdraw If true, sort triangle clusters for overdraw.
+ *
+ * @return ACMR before and after.
+ */
+template<typename VertexType>
+MeshOptimizerStats	optimizeMesh(std::vector<VertexType> &vertices, std::vector<uint32_t> &indices,
+									bool overdraw = true)
+{
+	MeshOptimizerStats	stats;
+	uint32_t			nbVertex = static_cast<uint32_t>(vertices.size());
+
+	stats.acmrBefore = computeAcmr(indices, nbVertex);
+
+	optimizeVertexCache(indices, nbVertex);
+
+	if (overdraw)
+	{
+		std::vector<gm::Vec3f>	positions(nbVertex);
+		for (uint32_t i = 0; i < nbVertex; i++)
+			positions[i] = vertices[i].pos;
+		optimizeOverdraw(indices, positions);
+	}
+
+	std::vector<uint32_t>	remap;
+	uint32_t				nbUsed = optimizeVertexFetch(indices, nbVertex, remap);
+	std::vector<VertexType>	reordered(nbUsed);
+
+	for (uint32_t i = 0; i < nbVertex; i++)
+	{
+		if (remap[i] != UINT32_MAX)
+			reordered[remap[i]] = vertices[i];
+	}
+	vertices.swap(reordered);
+
+	stats.acmrAfter = computeAcmr(indices, nbUsed);
+
+	return (stats);
+}
+
+#endif
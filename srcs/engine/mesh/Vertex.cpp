@@ -1,5 +1,7 @@
 #include <engine/mesh/Vertex.hpp>
 
+#include <functional>
+
 //**** STATIC FUNCTIONS DEFINE *************************************************
 //**** INITIALISION ************************************************************
 //---- Constructors ------------------------------------------------------------
@@ -70,44 +72,6 @@ std::size_t	Vertex::getHash(void)
 }
 
 //**** STATIC METHODS **********************************************************
-
-VkVertexInputBindingDescription	Vertex::getBindingDescription(void)
-{
-	VkVertexInputBindingDescription bindingDescription{};
-
-	bindingDescription.binding = 0;
-	bindingDescription.stride = sizeof(Vertex);
-	bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-
-	return (bindingDescription);
-}
-
-
-std::array<VkVertexInputAttributeDescription, 3>	Vertex::getAttributeDescriptions(void)
-{
-	std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions{};
-
-	// Bind info for location 0
-	attributeDescriptions[0].binding = 0;
-	attributeDescriptions[0].location = 0;
-	attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-	attributeDescriptions[0].offset = offsetof(Vertex, pos);
-
-	// Bind info for location 1
-	attributeDescriptions[1].binding = 0;
-	attributeDescriptions[1].location = 1;
-	attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-	attributeDescriptions[1].offset = offsetof(Vertex, nrm);
-
-	// Bind info for location 2
-	attributeDescriptions[2].binding = 0;
-	attributeDescriptions[2].location = 2;
-	attributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;
-	attributeDescriptions[2].offset = offsetof(Vertex, tex);
-
-	return (attributeDescriptions);
-}
-
 //**** PRIVATE METHODS *********************************************************
 //**** FUNCTIONS ***************************************************************
 //**** STATIC FUNCTIONS ********************************************************
@@ -1,13 +1,13 @@
 #ifndef VERTEX_HPP
 # define VERTEX_HPP
 
-# include <define.hpp>
+# include <defineCore.hpp>
 
-# include <array>
+# include <cstddef>
 # include <gmath.hpp>
 
 /**
- * @brief Class for 3D vertex with a position, a normal and a texture coordinates. Made to work with Vulkan.
+ * @brief Class for 3D vertex with a position, a normal and a texture coordinates. Vulkan input layout is described in VertexInput.hpp.
  */
 class Vertex
 {
@@ -81,18 +81,6 @@ public:
 	std::size_t	getHash(void);
 
 //**** STATIC METHODS **********************************************************
-	/**
-	 * @brief Get binding description for Vulkan.
-	 *
-	 * @return The VkVertexInputBindingDescription for Vertex class.
-	 */
-	static VkVertexInputBindingDescription	getBindingDescription(void);
-	/**
-	 * @brief Get attribute description for Vulkan.
-	 *
-	 * @return The VkVertexInputAttributeDescription for Vertex class.
-	 */
-	static std::array<VkVertexInputAttributeDescription, 3>	getAttributeDescriptions(void);
 
 private:
 //**** PRIVATE ATTRIBUTS *******************************************************
@@ -0,0 +1,108 @@
+#include <engine/mesh/VertexInput.hpp>
+
+#include <cstddef>
+
+//**** VERTEX ******************************************************************
+
+VkVertexInputBindingDescription	VertexInput<Vertex>::getBindingDescription(void)
+{
+	VkVertexInputBindingDescription bindingDescription{};
+
+	bindingDescription.binding = 0;
+	bindingDescription.stride = sizeof(Vertex);
+	bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+	return (bindingDescription);
+}
+
+
+std::array<VkVertexInputAttributeDescription, 3>	VertexInput<Vertex>::getAttributeDescriptions(void)
+{
+	std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions{};
+
+	// Bind info for location 0
+	attributeDescriptions[0].binding = 0;
+	attributeDescriptions[0].location = 0;
+	attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+	attributeDescriptions[0].offset = offsetof(Vertex, pos);
+
+	// Bind info for location 1
+	attributeDescriptions[1].binding = 0;
+	attributeDescriptions[1].location = 1;
+	attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+	attributeDescriptions[1].offset = offsetof(Vertex, nrm);
+
+	// Bind info for location 2
+	attributeDescriptions[2].binding = 0;
+	attributeDescriptions[2].location = 2;
+	attributeDescriptions[2].format = VK_FORMAT_R32G32_SFLOAT;
+	attributeDescriptions[2].offset = offsetof(Vertex, tex);
+
+	return (attributeDescriptions);
+}
+
+//**** VERTEX POS **************************************************************
+
+VkVertexInputBindingDescription	VertexInput<VertexPos>::getBindingDescription(void)
+{
+	VkVertexInputBindingDescription bindingDescription{};
+
+	bindingDescription.binding = 0;
+	bindingDescription.stride = sizeof(VertexPos);
+	bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+	return (bindingDescription);
+}
+
+
+std::array<VkVertexInputAttributeDescription, 2>	VertexInput<VertexPos>::getAttributeDescriptions(void)
+{
+	std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
+
+	// Bind info for location 0
+	attributeDescriptions[0].binding = 0;
+	attributeDescriptions[0].location = 0;
+	attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+	attributeDescriptions[0].offset = offsetof(VertexPos, pos);
+
+	// Bind info for location 1
+	attributeDescriptions[1].binding = 0;
+	attributeDescriptions[1].location = 1;
+	attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+	attributeDescriptions[1].offset = offsetof(VertexPos, nrm);
+
+	return (attributeDescriptions);
+}
+
+//**** INSTANCE POS ************************************************************
+
+VkVertexInputBindingDescription	VertexInput<InstancePos>::getBindingDescription(void)
+{
+	VkVertexInputBindingDescription bindingDescription{};
+
+	bindingDescription.binding = 1;
+	bindingDescription.stride = sizeof(InstancePos);
+	bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+	return (bindingDescription);
+}
+
+
+std::array<VkVertexInputAttributeDescription, 2>	VertexInput<InstancePos>::getAttributeDescriptions(uint32_t firstLocation)
+{
+	std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
+
+	// Bind info for first location
+	attributeDescriptions[0].binding = 1;
+	attributeDescriptions[0].location = firstLocation;
+	attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+	attributeDescriptions[0].offset = offsetof(InstancePos, pos);
+
+	// Bind info for next location
+	attributeDescriptions[1].binding = 1;
+	attributeDescriptions[1].location = firstLocation + 1;
+	attributeDescriptions[1].format = VK_FORMAT_R32_SFLOAT;
+	attributeDescriptions[1].offset = offsetof(InstancePos, scale);
+
+	return (attributeDescriptions);
+}
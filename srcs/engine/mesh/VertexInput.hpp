@@ -0,0 +1,81 @@
+#ifndef VERTEX_INPUT_HPP
+# define VERTEX_INPUT_HPP
+
+# include <define.hpp>
+# include <engine/mesh/Vertex.hpp>
+# include <engine/mesh/VertexPos.hpp>
+# include <engine/mesh/InstancePos.hpp>
+
+# include <array>
+
+/**
+ * @brief Vulkan vertex input layout of a vertex or instance type, kept out of
+ * the types themselves so cpu only code can use them without Vulkan.
+ * Specialized for each type usable by Shader.
+ */
+template<typename VertexType>
+struct VertexInput;
+
+/**
+ * @brief Vulkan vertex input layout of Vertex, at binding 0.
+ */
+template<>
+struct VertexInput<Vertex>
+{
+	/**
+	 * @brief Get binding description for Vulkan.
+	 *
+	 * @return The VkVertexInputBindingDescription for Vertex class.
+	 */
+	static VkVertexInputBindingDescription	getBindingDescription(void);
+	/**
+	 * @brief Get attribute description for Vulkan.
+	 *
+	 * @return The VkVertexInputAttributeDescription for Vertex class.
+	 */
+	static std::array<VkVertexInputAttributeDescription, 3>	getAttributeDescriptions(void);
+};
+
+/**
+ * @brief Vulkan vertex input layout of VertexPos, at binding 0.
+ */
+template<>
+struct VertexInput<VertexPos>
+{
+	/**
+	 * @brief Get binding description for Vulkan.
+	 *
+	 * @return The VkVertexInputBindingDescription for VertexPos class.
+	 */
+	static VkVertexInputBindingDescription	getBindingDescription(void);
+	/**
+	 * @brief Get attribute description for Vulkan.
+	 *
+	 * @return The VkVertexInputAttributeDescription for VertexPos class.
+	 */
+	static std::array<VkVertexInputAttributeDescription, 2>	getAttributeDescriptions(void);
+};
+
+/**
+ * @brief Vulkan vertex input layout of InstancePos, at binding 1.
+ */
+template<>
+struct VertexInput<InstancePos>
+{
+	/**
+	 * @brief Get binding description for Vulkan, advanced once per instance.
+	 *
+	 * @return The VkVertexInputBindingDescription for InstancePos class.
+	 */
+	static VkVertexInputBindingDescription	getBindingDescription(void);
+	/**
+	 * @brief Get attribute description for Vulkan.
+	 *
+	 * @param firstLocation First free location, after vertex attributes.
+	 *
+	 * @return The VkVertexInputAttributeDescription for InstancePos class.
+	 */
+	static std::array<VkVertexInputAttributeDescription, 2>	getAttributeDescriptions(uint32_t firstLocation);
+};
+
+#endif
@@ -1,5 +1,7 @@
 #include <engine/mesh/VertexPos.hpp>
 
+#include <functional>
+
 //**** STATIC FUNCTIONS DEFINE *************************************************
 //**** INITIALISION ************************************************************
 //---- Constructors ------------------------------------------------------------
@@ -64,38 +66,6 @@ std::size_t	VertexPos::getHash(void)
 }
 
 //**** STATIC METHODS **********************************************************
-
-VkVertexInputBindingDescription	VertexPos::getBindingDescription(void)
-{
-	VkVertexInputBindingDescription bindingDescription{};
-
-	bindingDescription.binding = 0;
-	bindingDescription.stride = sizeof(VertexPos);
-	bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-
-	return (bindingDescription);
-}
-
-
-std::array<VkVertexInputAttributeDescription, 2>	VertexPos::getAttributeDescriptions(void)
-{
-	std::array<VkVertexInputAttributeDescription, 2> attributeDescriptions{};
-
-	// Bind info for location 0
-	attributeDescriptions[0].binding = 0;
-	attributeDescriptions[0].location = 0;
-	attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-	attributeDescriptions[0].offset = offsetof(VertexPos, pos);
-
-	// Bind info for location 1
-	attributeDescriptions[1].binding = 0;
-	attributeDescriptions[1].location = 1;
-	attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
-	attributeDescriptions[1].offset = offsetof(VertexPos, nrm);
-
-	return (attributeDescriptions);
-}
-
 //**** PRIVATE METHODS *********************************************************
 //**** FUNCTIONS ***************************************************************
 //**** STATIC FUNCTIONS ********************************************************
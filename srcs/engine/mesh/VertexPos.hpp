@@ -1,13 +1,13 @@
 #ifndef VERTEX_POS_HPP
 # define VERTEX_POS_HPP
 
-# include <define.hpp>
+# include <defineCore.hpp>
 
-# include <array>
+# include <cstddef>
 # include <gmath.hpp>
 
 /**
- * @brief Class for 3D vertex with a position and a normal. Made to work with Vulkan.
+ * @brief Class for 3D vertex with a position and a normal. Vulkan input layout is described in VertexInput.hpp.
  */
 class VertexPos
 {
@@ -76,18 +76,6 @@ public:
 	std::size_t	getHash(void);
 
 //**** STATIC METHODS **********************************************************
-	/**
-	 * @brief Get binding description for Vulkan.
-	 *
-	 * @return The VkVertexInputBindingDescription for VertexPos class.
-	 */
-	static VkVertexInputBindingDescription	getBindingDescription(void);
-	/**
-	 * @brief Get attribute description for Vulkan.
-	 *
-	 * @return The VkVertexInputAttributeDescription for VertexPos class.
-	 */
-	static std::array<VkVertexInputAttributeDescription, 2>	getAttributeDescriptions(void);
 
 private:
 //**** PRIVATE ATTRIBUTS *******************************************************
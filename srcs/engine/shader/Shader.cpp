@@ -12,8 +12,12 @@ Shader::Shader(void)
 {
 	this->descriptorSetLayout = NULL;
 	this->pipelineLayout = NULL;
-	this->graphicsPipeline = NULL;
-	this->descriptorPool = NULL;
+	this->descriptorSet = NULL;
+	this->descriptorSetReset = 0;
+	this->dynamicOffsetsReset = 0;
+	this->pushConstantsSize = 0;
+	this->uboChanged = true;
+	this->copyDevice = NULL;
 }
 
 
@@ -21,8 +25,12 @@ Shader::Shader(const Shader &obj)
 {
 	this->descriptorSetLayout = NULL;
 	this->pipelineLayout = NULL;
-	this->graphicsPipeline = NULL;
-	this->descriptorPool = NULL;
+	this->descriptorSet = NULL;
+	this->descriptorSetReset = 0;
+	this->dynamicOffsetsReset = 0;
+	this->pushConstantsSize = 0;
+	this->uboChanged = true;
+	this->copyDevice = NULL;
 }
 
 //---- Destructor --------------------------------------------------------------
@@ -40,15 +48,123 @@ VkPipelineLayout	Shader::getPipelineLayout(void)
 }
 
 
-VkPipeline	Shader::getGraphicsPipeline(void)
+VkPipeline	Shader::getGraphicsPipeline(uint32_t variant)
 {
-	return (this->graphicsPipeline);
+	return (this->graphicsPipelines[variant]);
 }
 
 
-std::vector<VkDescriptorSet>	&Shader::getDescriptorSets(void)
+uint32_t	Shader::getNbVariants(void) const
 {
-	return (this->descriptorSets);
+	return (this->graphicsPipelines.size());
+}
+
+
+VkDescriptorSet	Shader::getDescriptorSet(Window &window)
+{
+	VulkanFrameAllocator	&frameAllocator = window.getFrameAllocator();
+
+	// Set only point to frame uniform buffer, so it's valid for all the frame
+	if (this->descriptorSet != NULL
+		&& this->descriptorSetReset == frameAllocator.getNbResets())
+		return (this->descriptorSet);
+
+	uint32_t	frame = window.getCurrentFrame();
+	uint32_t	nbUbo = this->uboTypes.size();
+	uint32_t	nbImages = this->imagesInfo.size();
+
+	this->descriptorSet = frameAllocator.allocateDescriptorSet(frame, this->descriptorSetLayout);
+	this->descriptorSetReset = frameAllocator.getNbResets();
+	// Previous offsets are in an other frame buffer
+	this->uboChanged = true;
+
+	// Ubo offsets are given at bind with dynamic offsets
+	std::vector<VkDescriptorBufferInfo>	buffersInfo(nbUbo);
+	for (uint32_t i = 0; i < nbUbo; i++)
+	{
+		buffersInfo[i].buffer = frameAllocator.getUniformBuffer(frame);
+		buffersInfo[i].offset = 0;
+		buffersInfo[i].range = this->uboTypes[i].size;
+	}
+
+	std::vector<VkWriteDescriptorSet> descriptorWrites(nbUbo + nbImages);
+	for (uint32_t i = 0; i < nbUbo; i++)
+	{
+		descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrites[i].dstSet = this->descriptorSet;
+		descriptorWrites[i].dstBinding = this->uboBindings[i];
+		descriptorWrites[i].dstArrayElement = 0;
+		descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		descriptorWrites[i].descriptorCount = 1;
+		descriptorWrites[i].pBufferInfo = &buffersInfo[i];
+	}
+
+	for (uint32_t i = 0; i < nbImages; i++)
+	{
+		uint32_t	id = nbUbo + i;
+
+		descriptorWrites[id].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		descriptorWrites[id].dstSet = this->descriptorSet;
+		descriptorWrites[id].dstBinding = this->imageBindings[i];
+		descriptorWrites[id].dstArrayElement = 0;
+		descriptorWrites[id].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		descriptorWrites[id].descriptorCount = 1;
+		descriptorWrites[id].pImageInfo = &this->imagesInfo[i];
+	}
+
+	vkUpdateDescriptorSets(this->copyDevice, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+
+	return (this->descriptorSet);
+}
+
+
+uint32_t	Shader::getDynamicOffsets(Window &window, uint32_t *dynamicOffsets)
+{
+	VulkanFrameAllocator	&frameAllocator = window.getFrameAllocator();
+	uint32_t				nbUbo = this->uboTypes.size();
+
+	// Copy ubo values into frame uniform buffer only if they changed
+	if (this->uboChanged || this->dynamicOffsetsReset != frameAllocator.getNbResets())
+	{
+		uint32_t				frame = window.getCurrentFrame();
+		VkDescriptorBufferInfo	bufferInfo;
+
+		for (uint32_t i = 0; i < nbUbo; i++)
+		{
+			void	*data = frameAllocator.allocateUniform(frame, this->uboTypes[i].size, bufferInfo);
+			memcpy(data, this->uboDatas[i].data(), this->uboTypes[i].size);
+			this->dynamicOffsets[i] = static_cast<uint32_t>(bufferInfo.offset);
+		}
+		this->dynamicOffsetsReset = frameAllocator.getNbResets();
+		this->uboChanged = false;
+	}
+
+	memcpy(dynamicOffsets, this->dynamicOffsets.data(), nbUbo * sizeof(uint32_t));
+
+	return (nbUbo);
+}
+
+const std::vector<VkPushConstantRange>	&Shader::getPushConstantRanges(void) const
+{
+	return (this->pushConstantRanges);
+}
+
+
+uint32_t	Shader::getPushConstantsSize(void) const
+{
+	return (this->pushConstantsSize);
+}
+
+
+const std::string	&Shader::getVertexPath(void) const
+{
+	return (this->vertexPath);
+}
+
+
+const std::string	&Shader::getFragmentPath(void) const
+{
+	return (this->fragmentPath);
 }
 
 //---- Setters -----------------------------------------------------------------
@@ -66,38 +182,86 @@ Shader	&Shader::operator=(const Shader &obj)
 
 void	Shader::destroy(Engine &engine)
 {
-	VkDevice	device = engine.context.getDevice();
+	VkDescriptorSetLayout	descriptorSetLayout = this->descriptorSetLayout;
+	std::vector<VkPipeline>	graphicsPipelines = std::move(this->graphicsPipelines);
+	VkPipelineLayout		pipelineLayout = this->pipelineLayout;
+
+	// Descriptor sets and uniforms are freed with frame allocator
+
+	// Frames in flight can still use pipeline, free it once GPU is done
+	engine.commandPool.getDeletionQueue().push(
+		[descriptorSetLayout, graphicsPipelines, pipelineLayout](VkDevice device)
+	{
+		// Free descriptor layout
+		if (descriptorSetLayout != NULL)
+			vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+
+		// Free pipelines of all variants
+		for (VkPipeline graphicsPipeline : graphicsPipelines)
+			vkDestroyPipeline(device, graphicsPipeline, nullptr);
+		if (pipelineLayout != NULL)
+			vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+	});
+
+	this->graphicsPipelines.clear();
+	this->descriptorSetLayout = NULL;
+	this->pipelineLayout = NULL;
+	this->descriptorSet = NULL;
+}
+
+
+void	Shader::reload(Engine &engine)
+{
+	if (!this->pipelineBuilder)
+		throw std::runtime_error("Shader isn't init");
+
+	// Descriptor set layout is kept, so new shaders must use same bindings
+	uint32_t						pushConstantsSize;
+	std::vector<ReflectedBinding>	bindings = this->reflectBindings(pushConstantsSize);
 
-	// Free uniforms buffers
-	size_t nbBuffers = this->uniformBuffers.size();
-	for (size_t i = 0; i < nbBuffers; i++)
+	if (pushConstantsSize != this->pushConstantsSize || bindings.size() != this->bindings.size())
+		throw std::runtime_error("Shader resources changed, restart is needed");
+	for (size_t i = 0; i < bindings.size(); i++)
 	{
-		if (this->uniformBuffers[i])
-			vkDestroyBuffer(device, this->uniformBuffers[i], nullptr);
-		if (this->uniformBuffersMemory[i])
-			vkFreeMemory(device, this->uniformBuffersMemory[i], nullptr);
+		if (bindings[i].binding != this->bindings[i].binding || bindings[i].type != this->bindings[i].type
+			|| bindings[i].count != this->bindings[i].count || bindings[i].size != this->bindings[i].size
+			|| bindings[i].stages != this->bindings[i].stages)
+			throw std::runtime_error("Shader resources changed, restart is needed");
 	}
 
-	// Free descriptor pool
-	if (this->descriptorPool != NULL)
-		vkDestroyDescriptorPool(device, this->descriptorPool, nullptr);
+	std::vector<VkPipeline>	oldPipelines = this->graphicsPipelines;
+	VkPipelineLayout		oldPipelineLayout = this->pipelineLayout;
 
-	// Free descriptor layout
-	if (this->descriptorSetLayout != NULL)
-		vkDestroyDescriptorSetLayout(device, this->descriptorSetLayout, nullptr);
+	try
+	{
+		this->pipelineBuilder(engine.context.getDevice(), engine.window);
+	}
+	catch (const std::exception &e)
+	{
+		// Destroy what was created before the failure, and keep old pipeline
+		VkDevice	device = engine.context.getDevice();
+
+		if (this->pipelineLayout != oldPipelineLayout)
+			vkDestroyPipelineLayout(device, this->pipelineLayout, nullptr);
+		this->graphicsPipelines = oldPipelines;
+		this->pipelineLayout = oldPipelineLayout;
+		throw;
+	}
 
-	// Free pipeline
-	if (this->graphicsPipeline != NULL)
-		vkDestroyPipeline(device, this->graphicsPipeline, nullptr);
-	if (this->pipelineLayout != NULL)
-		vkDestroyPipelineLayout(device, this->pipelineLayout, nullptr);
+	// Frames in flight can still use old pipeline
+	engine.commandPool.getDeletionQueue().push([oldPipelines, oldPipelineLayout](VkDevice device)
+	{
+		for (VkPipeline oldPipeline : oldPipelines)
+			vkDestroyPipeline(device, oldPipeline, nullptr);
+		vkDestroyPipelineLayout(device, oldPipelineLayout, nullptr);
+	});
 }
 
 
-void	Shader::updateUBO(Window &window, void *ubo, int uboId)
+void	Shader::updateUBO(void *ubo, int uboId)
 {
-	int	bufferId = window.getCurrentFrame() * this->uboTypes.size() + uboId;
-	memcpy(this->uniformBuffersMapped[bufferId], ubo, this->uboTypes[uboId].size);
+	memcpy(this->uboDatas[uboId].data(), ubo, this->uboTypes[uboId].size);
+	this->uboChanged = true;
 }
 
 //**** STATIC METHODS **********************************************************
@@ -105,171 +269,153 @@ void	Shader::updateUBO(Window &window, void *ubo, int uboId)
 
 void	Shader::createDescriptorSetLayout(VkDevice device, size_t nbImages)
 {
-	int	nbUbo = this->uboTypes.size();
+	uint32_t	pushConstantsSize;
+
+	this->bindings = this->reflectBindings(pushConstantsSize);
+	this->uboBindings.clear();
+	this->imageBindings.clear();
 
-	std::vector<VkDescriptorSetLayoutBinding> bindings(nbUbo + nbImages);
+	if (pushConstantsSize != this->pushConstantsSize)
+		throw std::runtime_error("Push constants mismatch, shader block is "
+									+ std::to_string(pushConstantsSize) + " bytes, given "
+									+ std::to_string(this->pushConstantsSize) + " bytes");
 
-	// Bind uniforms to shaders
-	std::vector<VkDescriptorSetLayoutBinding> uboLayoutBindings(nbUbo);
-	for (int i = 0; i < nbUbo; i++)
+	std::vector<VkDescriptorSetLayoutBinding>	layoutBindings(this->bindings.size());
+
+	for (size_t i = 0; i < this->bindings.size(); i++)
 	{
-		uboLayoutBindings[i].binding = i;
-		uboLayoutBindings[i].descriptorCount = 1;
-		uboLayoutBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-		uboLayoutBindings[i].pImmutableSamplers = nullptr; // Optional
-		if (this->uboTypes[i].location == UBO_VERTEX)
-			uboLayoutBindings[i].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-		else
-			uboLayoutBindings[i].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+		const ReflectedBinding	&binding = this->bindings[i];
+
+		if (binding.set != 0)
+			throw std::runtime_error("Only descriptor set 0 is supported");
 
-		bindings[i] = uboLayoutBindings[i];
+		layoutBindings[i].binding = binding.binding;
+		layoutBindings[i].descriptorCount = binding.count;
+		layoutBindings[i].stageFlags = binding.stages;
+		layoutBindings[i].pImmutableSamplers = nullptr; // Optional
+
+		if (binding.type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+		{
+			// Ubo values are allocated per draw, so they use dynamic offsets
+			layoutBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+			this->uboBindings.push_back(binding.binding);
+		}
+		else if (binding.type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER && binding.count == 1)
+		{
+			layoutBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+			this->imageBindings.push_back(binding.binding);
+		}
+		else
+			throw std::runtime_error("Binding " + std::to_string(binding.binding)
+										+ " use an unsupported descriptor type");
 	}
 
-	// Bind sampler to shaders
-	std::vector<VkDescriptorSetLayoutBinding> samplerLayoutBindings(nbImages);
-	for (size_t i = 0; i < nbImages; i++)
+	// Check that given ubo and images match shader
+	size_t	nbUbo = this->uboBindings.size();
+	if (nbUbo != this->uboTypes.size())
+		throw std::runtime_error("Ubo mismatch, shader use " + std::to_string(nbUbo)
+									+ " ubo, given " + std::to_string(this->uboTypes.size()));
+	if (nbUbo > SHADER_MAX_UBO)
+		throw std::runtime_error("Too many ubo in shader");
+	if (this->imageBindings.size() != nbImages)
+		throw std::runtime_error("Images mismatch, shader use " + std::to_string(this->imageBindings.size())
+									+ " images, given " + std::to_string(nbImages));
+
+	size_t	uboId = 0;
+	for (const ReflectedBinding &binding : this->bindings)
 	{
-		samplerLayoutBindings[i].binding = nbUbo + i;
-		samplerLayoutBindings[i].descriptorCount = 1;
-		samplerLayoutBindings[i].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-		samplerLayoutBindings[i].pImmutableSamplers = nullptr;
-		samplerLayoutBindings[i].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-
-		bindings[nbUbo + i] = samplerLayoutBindings[i];
+		if (binding.type != VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+			continue ;
+
+		const UBOType		&uboType = this->uboTypes[uboId];
+		VkShaderStageFlags	stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+		if (uboType.location == UBO_VERTEX)
+			stage = VK_SHADER_STAGE_VERTEX_BIT;
+
+		if (binding.size != uboType.size)
+			throw std::runtime_error("Ubo " + std::to_string(uboId) + " mismatch, shader block is "
+										+ std::to_string(binding.size) + " bytes, given "
+										+ std::to_string(uboType.size) + " bytes");
+		if ((binding.stages & stage) == 0)
+			throw std::runtime_error("Ubo " + std::to_string(uboId) + " isn't used at given location");
+		uboId++;
 	}
 
 	VkDescriptorSetLayoutCreateInfo layoutInfo{};
 	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-	layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
-	layoutInfo.pBindings = bindings.data();
+	layoutInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+	layoutInfo.pBindings = layoutBindings.data();
 
 	if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &this->descriptorSetLayout) != VK_SUCCESS)
 		throw std::runtime_error("Create descriptor set layout failed");
 }
 
 
-void	Shader::createUniformBuffers(VkDevice device, VkPhysicalDevice physicalDevice)
+std::vector<ReflectedBinding>	Shader::reflectBindings(uint32_t &pushConstantsSize)
 {
-	int	nbUbo = this->uboTypes.size();
-	int	nbBuffers = MAX_FRAMES_IN_FLIGHT * nbUbo;
+	std::vector<ShaderReflection>	reflections = {
+		reflectSpirv(readFile(this->vertexPath)),
+		reflectSpirv(readFile(this->fragmentPath)),
+	};
 
-	this->uniformBuffers.resize(nbBuffers);
-	this->uniformBuffersMemory.resize(nbBuffers);
-	this->uniformBuffersMapped.resize(nbBuffers);
+	pushConstantsSize = 0;
+	for (const ShaderReflection &reflection : reflections)
+		pushConstantsSize = std::max(pushConstantsSize, reflection.pushConstantsSize);
 
-	int	bufferId;
-	int	bufferOffset = 0;
-	for (int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-	{
-		for (int j = 0; j < nbUbo; j++)
-		{
-			bufferId = bufferOffset + j;
-			createVulkanBuffer(device, physicalDevice,
-								this->uboTypes[j].size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-								VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-								this->uniformBuffers[bufferId], this->uniformBuffersMemory[bufferId]);
-			vkMapMemory(device, this->uniformBuffersMemory[bufferId], 0, this->uboTypes[j].size, 0, &this->uniformBuffersMapped[bufferId]);
-		}
-		bufferOffset += nbUbo;
-	}
+	return (mergeReflections(reflections));
 }
 
 
-void	Shader::createDescriptorPool(VkDevice device, size_t nbImages)
+void	Shader::createPushConstantRanges(const std::vector<PushConstantType> &pushConstantTypes)
 {
-	uint32_t maxFramesInFlight = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
-	size_t nbUbo = this->uboTypes.size();
+	size_t		nbPushConstants = pushConstantTypes.size();
+	uint32_t	offset = 0;
 
-	std::vector<VkDescriptorPoolSize> poolSizes(nbUbo + nbImages);
-	for (size_t i = 0; i < nbUbo; i++)
-	{
-		poolSizes[i].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-		poolSizes[i].descriptorCount = maxFramesInFlight;
-	}
-	for (size_t i = 0; i < nbImages; i++)
+	this->pushConstantRanges.resize(nbPushConstants);
+	for (size_t i = 0; i < nbPushConstants; i++)
 	{
-		poolSizes[nbUbo + i].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-		poolSizes[nbUbo + i].descriptorCount = maxFramesInFlight;
+		this->pushConstantRanges[i].offset = offset;
+		this->pushConstantRanges[i].size = pushConstantTypes[i].size;
+		if (pushConstantTypes[i].location == UBO_VERTEX)
+			this->pushConstantRanges[i].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		else
+			this->pushConstantRanges[i].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		offset += pushConstantTypes[i].size;
 	}
 
-	VkDescriptorPoolCreateInfo poolInfo{};
-	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-	poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-	poolInfo.pPoolSizes = poolSizes.data();
-	poolInfo.maxSets = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+	if (offset > SHADER_MAX_PUSH_CONSTANTS_SIZE)
+		throw std::runtime_error("Push constants are too big");
 
-	if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &this->descriptorPool) != VK_SUCCESS)
-		throw std::runtime_error("Create descriptor pool failed");
+	this->pushConstantsSize = offset;
 }
 
 
-void	Shader::createDescriptorSets(
+void	Shader::createDescriptorDatas(
 					VkDevice device,
 					const std::vector<const Image *> &images)
 {
-	std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, this->descriptorSetLayout);
-	VkDescriptorSetAllocateInfo allocInfo{};
-	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-	allocInfo.descriptorPool = this->descriptorPool;
-	allocInfo.descriptorSetCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
-	allocInfo.pSetLayouts = layouts.data();
+	this->copyDevice = device;
 
-	this->descriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
-	if (vkAllocateDescriptorSets(device, &allocInfo, this->descriptorSets.data()) != VK_SUCCESS)
-		throw std::runtime_error("Allocate descriptor sets failed");
-
-	// Get images
-	uint32_t nbUbo = this->uboTypes.size();
-	uint32_t nbImages = images.size();
+	// Ubo values start at zero until first update
+	size_t	nbUbo = this->uboTypes.size();
+	this->uboDatas.resize(nbUbo);
+	for (size_t i = 0; i < nbUbo; i++)
+		this->uboDatas[i].assign(this->uboTypes[i].size, 0);
 
 	// Create images struct
-	std::vector<VkDescriptorImageInfo>	imagesInfo(nbImages);
-	for (uint32_t i = 0; i < nbImages; i++)
+	size_t	nbImages = images.size();
+	this->imagesInfo.resize(nbImages);
+	for (size_t i = 0; i < nbImages; i++)
 	{
-		imagesInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		imagesInfo[i].imageView = images[i]->view;
-		imagesInfo[i].sampler = images[i]->sampler;
+		this->imagesInfo[i].imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		this->imagesInfo[i].imageView = images[i]->view;
+		this->imagesInfo[i].sampler = images[i]->sampler;
 	}
 
-	// Init sets for each frame
-	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-	{
-		// Create ubo struct
-		std::vector<VkDescriptorBufferInfo>	buffersInfo(nbUbo);
-		for (uint32_t j = 0; j < nbUbo; j++)
-		{
-			buffersInfo[j].buffer = this->uniformBuffers[i * nbUbo + j];
-			buffersInfo[j].offset = 0;
-			buffersInfo[j].range = this->uboTypes[j].size;
-		}
-
-		std::vector<VkWriteDescriptorSet> descriptorWrites(nbUbo + nbImages);
-		for (uint32_t j = 0; j < nbUbo; j++)
-		{
-			descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			descriptorWrites[j].dstSet = this->descriptorSets[i];
-			descriptorWrites[j].dstBinding = j;
-			descriptorWrites[j].dstArrayElement = 0;
-			descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			descriptorWrites[j].descriptorCount = 1;
-			descriptorWrites[j].pBufferInfo = &buffersInfo[j];
-		}
-
-		for (uint32_t j = 0; j < nbImages; j++)
-		{
-			uint32_t	id = nbUbo + j;
-
-			descriptorWrites[id].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			descriptorWrites[id].dstSet = this->descriptorSets[i];
-			descriptorWrites[id].dstBinding = id;
-			descriptorWrites[id].dstArrayElement = 0;
-			descriptorWrites[id].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			descriptorWrites[id].descriptorCount = 1;
-			descriptorWrites[id].pImageInfo = &imagesInfo[j];
-		}
-
-		vkUpdateDescriptorSets(device, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
-	}
+	this->descriptorSet = NULL;
+	this->dynamicOffsets.assign(nbUbo, 0);
+	this->uboChanged = true;
 }
 
 //**** FUNCTIONS ***************************************************************
@@ -5,9 +5,14 @@
 # include <engine/engine.hpp>
 # include <engine/window/Window.hpp>
 # include <engine/textures/TextureManager.hpp>
+# include <engine/shader/SpirvReflection.hpp>
+# include <engine/mesh/VertexInput.hpp>
 
+# include <array>
 # include <string>
+# include <functional>
 # include <fstream>
+# include <type_traits>
 # include <gmath.hpp>
 
 enum FaceCulling
@@ -33,6 +38,10 @@ enum UBOLocation
 };
 
 
+/**
+ * @brief Struct given at shader init for each ubo, in binding order.
+ * It is checked against ubo blocks read in SPIR-V.
+ */
 struct UBOType
 {
 	size_t		size;
@@ -40,6 +49,24 @@ struct UBOType
 };
 
 
+struct PushConstantType
+{
+	uint32_t	size;
+	UBOLocation	location;
+};
+
+
+/**
+ * @brief Value of a specialization constant, 'constant_id' in GLSL.
+ * Bool values must be given as VkBool32, float values as their bits.
+ */
+struct SpecConstant
+{
+	uint32_t	id;
+	uint32_t	value;
+};
+
+
 //**** STATIC DEFINE FUNCTIONS *************************************************
 
 static inline std::vector<const Image *>	getImages(const TextureManager &textureManager, const std::vector<std::string> &imageIds);
@@ -85,17 +112,68 @@ public:
 	 */
 	VkPipelineLayout	getPipelineLayout(void);
 	/**
-	 * @brief Getter of graphic pipeline.
+	 * @brief Getter of graphic pipeline of a variant.
+	 *
+	 * @param variant Id of variant in init vector, 0 is the base pipeline.
+	 * Id isn't check for speed.
 	 *
 	 * @return The graphic pipeline.
 	 */
-	VkPipeline	getGraphicsPipeline(void);
+	VkPipeline	getGraphicsPipeline(uint32_t variant = 0);
 	/**
-	 * @brief Getter of descriptor sets.
+	 * @brief Getter of number of pipeline variants.
 	 *
-	 * @return The descriptor sets.
+	 * @return Number of variants, at least 1.
 	 */
-	std::vector<VkDescriptorSet>	&getDescriptorSets(void);
+	uint32_t	getNbVariants(void) const;
+	/**
+	 * @brief Getter of descriptor set. The set is allocated from frame
+	 * allocator once per frame, ubo are bound as dynamic uniform buffers in
+	 * the frame uniform buffer.
+	 *
+	 * @param window Window class of the engine.
+	 *
+	 * @return The descriptor set, valid until the end of current frame.
+	 * @exception Throw a runtime_error if frame allocator is full.
+	 */
+	VkDescriptorSet	getDescriptorSet(Window &window);
+	/**
+	 * @brief Getter of dynamic offsets of current ubo values. Values are
+	 * copied into frame uniform buffer only if ubo changed since last call or
+	 * if the frame changed.
+	 *
+	 * @param window Window class of the engine.
+	 * @param dynamicOffsets Filled with one offset per ubo, must have room for
+	 * SHADER_MAX_UBO offsets.
+	 *
+	 * @return The number of offsets, equal to the number of ubo.
+	 * @exception Throw a runtime_error if frame uniform buffer is full.
+	 */
+	uint32_t	getDynamicOffsets(Window &window, uint32_t *dynamicOffsets);
+	/**
+	 * @brief Getter of push constant ranges, one per push constant type.
+	 *
+	 * @return Reference to push constant ranges.
+	 */
+	const std::vector<VkPushConstantRange>	&getPushConstantRanges(void) const;
+	/**
+	 * @brief Getter of total size of push constants.
+	 *
+	 * @return Size in bytes of all push constants.
+	 */
+	uint32_t	getPushConstantsSize(void) const;
+	/**
+	 * @brief Getter of vertex SPIR-V path.
+	 *
+	 * @return Reference to vertex path.
+	 */
+	const std::string	&getVertexPath(void) const;
+	/**
+	 * @brief Getter of fragment SPIR-V path.
+	 *
+	 * @return Reference to fragment path.
+	 */
+	const std::string	&getFragmentPath(void) const;
 
 //---- Setters -----------------------------------------------------------------
 //---- Operators ---------------------------------------------------------------
@@ -117,20 +195,17 @@ public:
 	 * @param vertexPath Path to compile vertex shader file.
 	 * @param fragmentPath Path to compile fragment shader file.
 	 */
-	template<typename VertexType>
+	template<typename VertexType, typename InstanceType = void>
 	void	init(
 				Engine &engine, FaceCulling faceCulling, DrawMode drawMode,
 				std::string vertexPath, std::string fragmentPath)
 	{
 		VkDevice	device = engine.context.getDevice();
-		VkPhysicalDevice	physicalDevice = engine.context.getPhysicalDevice();
 
+		this->createPipelineBuilder<VertexType, InstanceType>(vertexPath, fragmentPath, faceCulling, drawMode);
 		this->createDescriptorSetLayout(device, 0);
-		this->createGraphicsPipeline<VertexType>(device, engine.window, vertexPath, fragmentPath,
-										faceCulling, drawMode);
-		this->createUniformBuffers(device, physicalDevice);
-		this->createDescriptorPool(device, 0);
-		this->createDescriptorSets(device, {});
+		this->pipelineBuilder(device, engine.window);
+		this->createDescriptorDatas(device, {});
 	}
 	/**
 	 * @brief Init shader from parameters.
@@ -141,23 +216,20 @@ public:
 	 * @param fragmentPath Path to compile fragment shader file.
 	 * @param uboTypes Vector of ubo types.
 	 */
-	template<typename VertexType>
+	template<typename VertexType, typename InstanceType = void>
 	void	init(
 				Engine &engine, FaceCulling faceCulling, DrawMode drawMode,
 				std::string vertexPath, std::string fragmentPath,
 				const std::vector<UBOType> &uboTypes)
 	{
 		VkDevice	device = engine.context.getDevice();
-		VkPhysicalDevice	physicalDevice = engine.context.getPhysicalDevice();
 
 		this->uboTypes = uboTypes;
 
+		this->createPipelineBuilder<VertexType, InstanceType>(vertexPath, fragmentPath, faceCulling, drawMode);
 		this->createDescriptorSetLayout(device, 0);
-		this->createGraphicsPipeline<VertexType>(device, engine.window, vertexPath, fragmentPath,
-										faceCulling, drawMode);
-		this->createUniformBuffers(device, physicalDevice);
-		this->createDescriptorPool(device, 0);
-		this->createDescriptorSets(device, {});
+		this->pipelineBuilder(device, engine.window);
+		this->createDescriptorDatas(device, {});
 	}
 	/**
 	 * @brief Init shader from parameters.
@@ -169,7 +241,7 @@ public:
 	 * @param uboTypes Vector of ubo types.
 	 * @param imageIds Vector of image id to used in shader.
 	 */
-	template<typename VertexType>
+	template<typename VertexType, typename InstanceType = void>
 	void	init(
 				Engine &engine, FaceCulling faceCulling, DrawMode drawMode,
 				std::string vertexPath, std::string fragmentPath,
@@ -177,18 +249,58 @@ public:
 				const std::vector<std::string> &imageIds)
 	{
 		VkDevice	device = engine.context.getDevice();
-		VkPhysicalDevice	physicalDevice = engine.context.getPhysicalDevice();
 
 		this->uboTypes = uboTypes;
 
 		std::vector<const Image *> images = getImages(engine.textureManager, imageIds);
 
+		this->createPipelineBuilder<VertexType, InstanceType>(vertexPath, fragmentPath, faceCulling, drawMode);
 		this->createDescriptorSetLayout(device, images.size());
-		this->createGraphicsPipeline<VertexType>(device, engine.window, vertexPath, fragmentPath,
-										faceCulling, drawMode);
-		this->createUniformBuffers(device, physicalDevice);
-		this->createDescriptorPool(device, images.size());
-		this->createDescriptorSets(device, images);
+		this->pipelineBuilder(device, engine.window);
+		this->createDescriptorDatas(device, images);
+	}
+	/**
+	 * @brief Init shader from parameters.
+	 *
+	 * @param engine The engine struct.
+	 * @param faceCulling How do face culling. Clock wise, counter or disable it.
+	 * @param vertexPath Path to compile vertex shader file.
+	 * @param fragmentPath Path to compile fragment shader file.
+	 * @param uboTypes Vector of ubo types.
+	 * @param imageIds Vector of image id to used in shader.
+	 * @param pushConstantTypes Vector of push constant types, packed one after
+	 * the other. Their values are given per draw to Window::draw.
+	 * @param variants Specialization constants of each pipeline variant. The
+	 * first one is the base pipeline, others are derivatives of it. If empty,
+	 * only the base pipeline is created without specialization.
+	 *
+	 * @tparam InstanceType Per instance data read at binding 1, after vertex
+	 * attributes, for Window::drawInstanced. void if shader isn't instanced.
+	 *
+	 * @exception Throw a runtime_error if push constants are bigger than
+	 * SHADER_MAX_PUSH_CONSTANTS_SIZE.
+	 */
+	template<typename VertexType, typename InstanceType = void>
+	void	init(
+				Engine &engine, FaceCulling faceCulling, DrawMode drawMode,
+				std::string vertexPath, std::string fragmentPath,
+				const std::vector<UBOType> &uboTypes,
+				const std::vector<std::string> &imageIds,
+				const std::vector<PushConstantType> &pushConstantTypes,
+				const std::vector<std::vector<SpecConstant>> &variants = {})
+	{
+		VkDevice	device = engine.context.getDevice();
+
+		this->uboTypes = uboTypes;
+		this->variants = variants;
+
+		std::vector<const Image *> images = getImages(engine.textureManager, imageIds);
+
+		this->createPushConstantRanges(pushConstantTypes);
+		this->createPipelineBuilder<VertexType, InstanceType>(vertexPath, fragmentPath, faceCulling, drawMode);
+		this->createDescriptorSetLayout(device, images.size());
+		this->pipelineBuilder(device, engine.window);
+		this->createDescriptorDatas(device, images);
 	}
 	/**
 	 * @brief Destroy vulkan's allocate attributs.
@@ -197,45 +309,86 @@ public:
 	 */
 	void	destroy(Engine &engine);
 	/**
-	 * @brief Update uniform values used by shader.destroy
+	 * @brief Rebuild pipelines of all variants from SPIR-V files, used for hot
+	 * reload. Old pipelines are given to deletion queue, so frames in flight
+	 * can end.
+	 * Must be called between two frames.
+	 *
+	 * @param engine The engine struct.
+	 *
+	 * @exception Throw a runtime_error if the rebuild failed, the shader then
+	 * keep its previous pipeline.
+	 */
+	void	reload(Engine &engine);
+	/**
+	 * @brief Update uniform values used by shader. Values are copied, so
+	 * shader can be drawn many times per frame with different values.
 	 *
- 	 * @param window Window class of the engine.
 	 * @param ubo Pointer of uniform values struct used for update.
 	 * @param uboId Id of ubo in init vector. Id isn't check for speed, will crash if pass an incorect id.
 	 */
-	void	updateUBO(Window &window, void *ubo, int uboId);
+	void	updateUBO(void *ubo, int uboId);
 
 //**** STATIC METHODS **********************************************************
 
 private:
 //**** PRIVATE ATTRIBUTS *******************************************************
-	std::vector<UBOType>			uboTypes;
-	VkDescriptorSetLayout			descriptorSetLayout;
-	VkPipelineLayout				pipelineLayout;
-	VkPipeline						graphicsPipeline;
-	std::vector<VkBuffer>			uniformBuffers;
-	std::vector<VkDeviceMemory>		uniformBuffersMemory;
-	std::vector<void*>				uniformBuffersMapped;
-	VkDescriptorPool				descriptorPool;
-	std::vector<VkDescriptorSet>	descriptorSets;
+	std::vector<UBOType>					uboTypes;
+	std::vector<ReflectedBinding>			bindings;
+	std::vector<uint32_t>					uboBindings;
+	std::vector<uint32_t>					imageBindings;
+	std::vector<VkPushConstantRange>		pushConstantRanges;
+	uint32_t								pushConstantsSize;
+	std::string								vertexPath;
+	std::string								fragmentPath;
+	std::function<void(VkDevice, Window &)>	pipelineBuilder;
+	VkDescriptorSetLayout					descriptorSetLayout;
+	VkPipelineLayout						pipelineLayout;
+	std::vector<VkPipeline>					graphicsPipelines;
+	std::vector<std::vector<SpecConstant>>	variants;
+	std::vector<std::vector<char>>			uboDatas;
+	std::vector<VkDescriptorImageInfo>		imagesInfo;
+	VkDescriptorSet							descriptorSet;
+	uint64_t								descriptorSetReset;
+	std::vector<uint32_t>					dynamicOffsets;
+	uint64_t								dynamicOffsetsReset;
+	bool									uboChanged;
+//---- Copy --------------------------------------------------------------------
+	VkDevice								copyDevice;
 
 //**** PRIVATE METHODS *********************************************************
 	/**
-	 * @brief Create descriptor set layout.
+	 * @brief Create descriptor set layout from bindings read in SPIR-V files.
+	 * Ubo, images and push constants given at init are checked against them.
 	 *
 	 * @param device The device of VulkanContext class.
 	 * @param nbImages The number of image used in shader.
+	 *
+	 * @exception Throw a runtime_error if shader and given types mismatch.
 	 */
 	void	createDescriptorSetLayout(VkDevice device, size_t nbImages);
 	/**
-	 * @brief Create graphic pipeline.
+	 * @brief Read descriptor bindings of vertex and fragment SPIR-V files.
+	 *
+	 * @param pushConstantsSize Filled with biggest push constant block size.
+	 *
+	 * @return Bindings used by shader, sorted by set then binding.
+	 * @exception Throw a runtime_error if a file can't be read or parsed.
+	 */
+	std::vector<ReflectedBinding>	reflectBindings(uint32_t &pushConstantsSize);
+	/**
+	 * @brief Create pipeline layout and graphic pipelines of all variants.
+	 * Variants are derivatives of the first one, so driver can reuse its work.
 	 *
 	 * @param device The device of VulkanContext class.
 	 * @param window The Window class.
 	 * @param vertexPath Path to compile vertex shader file.
 	 * @param fragmentPath Path to compile fragment shader file.
+	 *
+	 * @exception Throw a runtime_error if a creation failed, nothing is
+	 * then kept except pipeline layout.
 	 */
-	template<typename VertexType>
+	template<typename VertexType, typename InstanceType>
 	void	createGraphicsPipeline(
 				VkDevice device, Window &window,
 				std::string vertexPath, std::string fragmentPath,
@@ -249,6 +402,26 @@ private:
 		VkShaderModule vertShaderModule = createShaderModule(device, vertShaderCode);
 		VkShaderModule fragShaderModule = createShaderModule(device, fragShaderCode);
 
+		// Constants of all variants are 32 bits, so entries only change ids
+		size_t									nbVariants = std::max<size_t>(this->variants.size(), 1);
+		std::vector<std::vector<VkSpecializationMapEntry>>	mapEntries(nbVariants);
+		std::vector<std::vector<uint32_t>>		specDatas(nbVariants);
+		std::vector<VkSpecializationInfo>		specInfos(nbVariants);
+		for (size_t i = 0; i < this->variants.size(); i++)
+		{
+			for (const SpecConstant &constant : this->variants[i])
+			{
+				mapEntries[i].push_back({constant.id,
+						static_cast<uint32_t>(specDatas[i].size() * sizeof(uint32_t)),
+						sizeof(uint32_t)});
+				specDatas[i].push_back(constant.value);
+			}
+			specInfos[i].mapEntryCount = static_cast<uint32_t>(mapEntries[i].size());
+			specInfos[i].pMapEntries = mapEntries[i].data();
+			specInfos[i].dataSize = specDatas[i].size() * sizeof(uint32_t);
+			specInfos[i].pData = specDatas[i].data();
+		}
+
 		// Create vertex shader stage
 		VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
 		vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -267,14 +440,25 @@ private:
 		VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
 		// Define vertex input
-		auto bindingDescription = VertexType::getBindingDescription();
-		auto attributeDescriptions = VertexType::getAttributeDescriptions();
+		auto vertexAttributes = VertexInput<VertexType>::getAttributeDescriptions();
+		std::vector<VkVertexInputBindingDescription>	bindingDescriptions = {VertexInput<VertexType>::getBindingDescription()};
+		std::vector<VkVertexInputAttributeDescription>	attributeDescriptions(vertexAttributes.begin(), vertexAttributes.end());
+
+		// Instance attributes take locations after vertex ones
+		if constexpr (!std::is_void_v<InstanceType>)
+		{
+			auto instanceAttributes = VertexInput<InstanceType>::getAttributeDescriptions(
+											static_cast<uint32_t>(attributeDescriptions.size()));
+			bindingDescriptions.push_back(VertexInput<InstanceType>::getBindingDescription());
+			attributeDescriptions.insert(attributeDescriptions.end(),
+											instanceAttributes.begin(), instanceAttributes.end());
+		}
 
 		VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
 		vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-		vertexInputInfo.vertexBindingDescriptionCount = 1;
+		vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
 		vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-		vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+		vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
 		vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
 		// Define in which way vertexes will be used (for triangle here)
@@ -368,8 +552,8 @@ private:
 		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 		pipelineLayoutInfo.setLayoutCount = 1;
 		pipelineLayoutInfo.pSetLayouts = &this->descriptorSetLayout;
-		pipelineLayoutInfo.pushConstantRangeCount = 0; // Optional
-		pipelineLayoutInfo.pPushConstantRanges = nullptr; // Optional
+		pipelineLayoutInfo.pushConstantRangeCount = static_cast<uint32_t>(this->pushConstantRanges.size());
+		pipelineLayoutInfo.pPushConstantRanges = this->pushConstantRanges.data();
 
 		if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &this->pipelineLayout) != VK_SUCCESS)
 			throw std::runtime_error("Pipeline layout creation failed");
@@ -405,34 +589,89 @@ private:
 		pipelineInfo.basePipelineHandle = VK_NULL_HANDLE; // Optional
 		pipelineInfo.basePipelineIndex = -1; // Optional
 
-		if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &this->graphicsPipeline) != VK_SUCCESS)
-			throw std::runtime_error("Graphics pipeline creation failed");
+		// Each variant need its own stages for its specialization info
+		std::vector<VkGraphicsPipelineCreateInfo>			pipelineInfos(nbVariants, pipelineInfo);
+		std::vector<std::array<VkPipelineShaderStageCreateInfo, 2>>	variantStages(nbVariants);
+		for (size_t i = 0; i < nbVariants; i++)
+		{
+			variantStages[i] = {vertShaderStageInfo, fragShaderStageInfo};
+			if (i < this->variants.size())
+			{
+				variantStages[i][0].pSpecializationInfo = &specInfos[i];
+				variantStages[i][1].pSpecializationInfo = &specInfos[i];
+			}
+			pipelineInfos[i].pStages = variantStages[i].data();
+		}
+		pipelineInfos[0].flags = VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT;
+
+		// Base pipeline first, derivatives need its handle
+		this->graphicsPipelines.assign(nbVariants, VK_NULL_HANDLE);
+		VkResult result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1,
+								&pipelineInfos[0], nullptr, &this->graphicsPipelines[0]);
+
+		if (result == VK_SUCCESS && nbVariants > 1)
+		{
+			for (size_t i = 1; i < nbVariants; i++)
+			{
+				pipelineInfos[i].flags = VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+				pipelineInfos[i].basePipelineHandle = this->graphicsPipelines[0];
+			}
+			result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, nbVariants - 1,
+								&pipelineInfos[1], nullptr, &this->graphicsPipelines[1]);
+		}
 
 		// Free shaders
 		vkDestroyShaderModule(device, fragShaderModule, nullptr);
 		vkDestroyShaderModule(device, vertShaderModule, nullptr);
+
+		if (result != VK_SUCCESS)
+		{
+			for (VkPipeline pipeline : this->graphicsPipelines)
+				if (pipeline != VK_NULL_HANDLE)
+					vkDestroyPipeline(device, pipeline, nullptr);
+			this->graphicsPipelines.clear();
+			throw std::runtime_error("Graphics pipeline creation failed");
+		}
 	}
 	/**
-	 * @brief Create uniform buffers to store uniform values used by shader.
+	 * @brief Save pipeline parameters in a builder, so pipeline can be
+	 * rebuilt by reload without knowing vertex type.
 	 *
-	 * @param device The device of VulkanContext class.
-	 * @param physicalDevice The physical device of VulkanContext class.
+	 * @param vertexPath Path to compile vertex shader file.
+	 * @param fragmentPath Path to compile fragment shader file.
+	 * @param faceCulling How do face culling. Clock wise, counter or disable it.
+	 * @param drawMode Polygon mode of the pipeline.
 	 */
-	void	createUniformBuffers(VkDevice device, VkPhysicalDevice physicalDevice);
+	template<typename VertexType, typename InstanceType>
+	void	createPipelineBuilder(
+				const std::string &vertexPath, const std::string &fragmentPath,
+				FaceCulling faceCulling, DrawMode drawMode)
+	{
+		this->vertexPath = vertexPath;
+		this->fragmentPath = fragmentPath;
+		this->pipelineBuilder = [this, faceCulling, drawMode](VkDevice device, Window &window)
+			{
+				this->createGraphicsPipeline<VertexType, InstanceType>(device, window,
+										this->vertexPath, this->fragmentPath,
+										faceCulling, drawMode);
+			};
+	}
 	/**
-	 * @brief Create descriptor pool.
+	 * @brief Create push constant ranges, packed one after the other.
 	 *
-	 * @param device The device of VulkanContext class.
-	 * @param nbImages The number of image used in shader.
+	 * @param pushConstantTypes Vector of push constant types.
+	 *
+	 * @exception Throw a runtime_error if push constants are too big.
 	 */
-	void	createDescriptorPool(VkDevice device, size_t nbImages);
+	void	createPushConstantRanges(const std::vector<PushConstantType> &pushConstantTypes);
 	/**
-	 * @brief Create descriptor sets.
+	 * @brief Create cpu copy of uniform values and images info used to write
+	 * descriptor sets.
 	 *
 	 * @param device The device of VulkanContext class.
 	 * @param images The vector of image that will be used in shader.
 	 */
-	void	createDescriptorSets(
+	void	createDescriptorDatas(
 				VkDevice device,
 				const std::vector<const Image *> &images);
 };
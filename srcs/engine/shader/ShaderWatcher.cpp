@@ -0,0 +1,235 @@
+#include <engine/shader/ShaderWatcher.hpp>
+
+#include <engine/shader/Shader.hpp>
+#include <engine/trace/Trace.hpp>
+
+#include <set>
+#include <cstdio>
+#include <cerrno>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/inotify.h>
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+
+static bool	runGlslc(const std::string &srcPath, const std::string &outPath);
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+
+ShaderWatcher::ShaderWatcher(void)
+{
+	this->inotifyFd = -1;
+	this->running = false;
+}
+
+//---- Destructor --------------------------------------------------------------
+
+ShaderWatcher::~ShaderWatcher()
+{
+	this->destroy();
+}
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+
+void	ShaderWatcher::init(const std::string &srcDir, const std::string &binDir)
+{
+	this->destroy();
+
+	this->srcDir = srcDir;
+	this->binDir = binDir;
+
+	this->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (this->inotifyFd < 0)
+		throw std::runtime_error("Inotify init failed");
+
+	// Editors often write a temporary file and move it, so watch both
+	if (inotify_add_watch(this->inotifyFd, srcDir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+	{
+		close(this->inotifyFd);
+		this->inotifyFd = -1;
+		throw std::runtime_error("Inotify watch of '" + srcDir + "' failed");
+	}
+
+	this->running = true;
+	this->thread = std::thread(&ShaderWatcher::watchLoop, this);
+}
+
+
+void	ShaderWatcher::destroy(void)
+{
+	this->running = false;
+	if (this->thread.joinable())
+		this->thread.join();
+
+	if (this->inotifyFd >= 0)
+	{
+		close(this->inotifyFd);
+		this->inotifyFd = -1;
+	}
+
+	this->compiledPaths.clear();
+	this->shaders.clear();
+}
+
+
+void	ShaderWatcher::addShader(Shader &shader)
+{
+	this->shaders.push_back(&shader);
+}
+
+
+void	ShaderWatcher::removeShader(Shader &shader)
+{
+	this->shaders.erase(std::remove(this->shaders.begin(), this->shaders.end(), &shader),
+						this->shaders.end());
+}
+
+
+void	ShaderWatcher::reloadShaders(Engine &engine)
+{
+	std::vector<std::string>	paths;
+
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		if (this->compiledPaths.empty())
+			return ;
+		paths.swap(this->compiledPaths);
+	}
+
+	TRACE_SCOPE("shader reload");
+
+	for (Shader *shader : this->shaders)
+	{
+		bool	changed = false;
+
+		for (const std::string &path : paths)
+			if (path == shader->getVertexPath() || path == shader->getFragmentPath())
+				changed = true;
+
+		if (!changed)
+			continue ;
+
+		try
+		{
+			shader->reload(engine);
+			std::cout << "Shader '" << shader->getVertexPath() << "' reloaded" << std::endl;
+		}
+		catch (const std::exception &e)
+		{
+			std::cerr << "Error : shader reload failed : " << e.what() << std::endl;
+		}
+	}
+}
+
+//**** STATIC METHODS **********************************************************
+//**** PRIVATE METHODS *********************************************************
+
+void	ShaderWatcher::watchLoop(void)
+{
+	char			buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	struct pollfd	pollFd = {this->inotifyFd, POLLIN, 0};
+
+	while (this->running)
+	{
+		// Timeout let the thread check if it must stop
+		if (poll(&pollFd, 1, 100) <= 0)
+			continue ;
+
+		// One save can give many events, compile each file once
+		std::set<std::string>	fileNames;
+		ssize_t					len;
+
+		while ((len = read(this->inotifyFd, buffer, sizeof(buffer))) > 0)
+		{
+			for (char *ptr = buffer; ptr < buffer + len;)
+			{
+				const struct inotify_event	*event = reinterpret_cast<const struct inotify_event *>(ptr);
+
+				if (event->len > 0)
+					fileNames.insert(event->name);
+				ptr += sizeof(struct inotify_event) + event->len;
+			}
+		}
+
+		for (const std::string &fileName : fileNames)
+			this->compileShader(fileName);
+	}
+}
+
+
+void	ShaderWatcher::compileShader(const std::string &fileName)
+{
+	size_t	dot = fileName.rfind('.');
+	if (dot == std::string::npos)
+		return ;
+
+	std::string	extension = fileName.substr(dot + 1);
+	if (extension != "vert" && extension != "frag")
+		return ;
+
+	std::string	srcPath = this->srcDir + "/" + fileName;
+	std::string	binPath = this->binDir + "/" + fileName.substr(0, dot) + "_" + extension + ".spv";
+
+	TRACE_SCOPE("shader compile");
+
+	// Compile in a temporary file, so a failed compilation keep the last SPIR-V
+	std::string	tmpPath = binPath + ".tmp";
+	if (!runGlslc(srcPath, tmpPath))
+	{
+		std::cerr << "Error : compilation of '" << srcPath << "' failed" << std::endl;
+		std::remove(tmpPath.c_str());
+		return ;
+	}
+
+	// Rename is atomic, a reload never read a partial file
+	if (std::rename(tmpPath.c_str(), binPath.c_str()) != 0)
+	{
+		std::cerr << "Error : can't replace '" << binPath << "'" << std::endl;
+		return ;
+	}
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->compiledPaths.push_back(binPath);
+}
+
+//**** FUNCTIONS ***************************************************************
+//**** STATIC FUNCTIONS ********************************************************
+
+static bool	runGlslc(const std::string &srcPath, const std::string &outPath)
+{
+	// No shell, so paths are never interpreted
+	char	*argv[] = {
+		const_cast<char *>("glslc"),
+		const_cast<char *>(srcPath.c_str()),
+		const_cast<char *>("-o"),
+		const_cast<char *>(outPath.c_str()),
+		NULL};
+
+	pid_t	pid = fork();
+	if (pid < 0)
+		return (false);
+
+	if (pid == 0)
+	{
+		execvp(argv[0], argv);
+		_exit(127);
+	}
+
+	int	status;
+	while (waitpid(pid, &status, 0) < 0)
+	{
+		if (errno != EINTR)
+			return (false);
+	}
+
+	return (WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
@@ -0,0 +1,109 @@
+#ifndef SHADER_WATCHER_HPP
+# define SHADER_WATCHER_HPP
+
+# include <define.hpp>
+
+# include <string>
+# include <vector>
+# include <thread>
+# include <mutex>
+# include <atomic>
+
+class Shader;
+struct Engine;
+
+/**
+ * @brief Class for shader hot reload. A background thread watch GLSL sources
+ * with inotify and compile changed files to SPIR-V with glslc. Shaders using
+ * new SPIR-V are rebuilt by reloadShaders, between two frames.
+ */
+class ShaderWatcher
+{
+public:
+//**** PUBLIC ATTRIBUTS ********************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Default contructor of ShaderWatcher class.
+	 *
+	 * @return The default ShaderWatcher that isn't watching.
+	 */
+	ShaderWatcher(void);
+
+//---- Destructor --------------------------------------------------------------
+	/**
+	 * @brief Destructor of ShaderWatcher class.
+	 */
+	~ShaderWatcher();
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+	/**
+	 * @brief Start watching a directory of GLSL sources.
+	 * A file 'name.vert' is compiled to 'binDir/name_vert.spv', same for frag.
+	 *
+	 * @param srcDir Directory of GLSL sources.
+	 * @param binDir Directory of SPIR-V files used by shaders.
+	 *
+	 * @warning Will stop the previous watch if there is one.
+	 * @exception Throw a runtime_error if inotify can't watch srcDir.
+	 */
+	void	init(const std::string &srcDir, const std::string &binDir);
+	/**
+	 * @brief Stop watching and join the background thread.
+	 */
+	void	destroy(void);
+	/**
+	 * @brief Add a shader to reload when its SPIR-V files are recompiled.
+	 *
+	 * @param shader Shader to reload, must live until destroy or removeShader.
+	 */
+	void	addShader(Shader &shader);
+	/**
+	 * @brief Remove a shader from reloaded shaders.
+	 *
+	 * @param shader Shader to remove.
+	 */
+	void	removeShader(Shader &shader);
+	/**
+	 * @brief Rebuild pipelines of shaders whose SPIR-V files changed.
+	 * Must be called between two frames, from the thread that draws.
+	 * If a rebuild failed, the shader keep its previous pipeline.
+	 *
+	 * @param engine The engine struct.
+	 */
+	void	reloadShaders(Engine &engine);
+
+//**** STATIC METHODS **********************************************************
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+	std::string					srcDir;
+	std::string					binDir;
+	int							inotifyFd;
+	std::thread					thread;
+	std::atomic<bool>			running;
+	std::mutex					mutex;
+	std::vector<std::string>	compiledPaths;
+	std::vector<Shader *>		shaders;
+
+//**** PRIVATE METHODS *********************************************************
+	/**
+	 * @brief Loop of background thread. Wait inotify events and compile
+	 * changed sources.
+	 */
+	void	watchLoop(void);
+	/**
+	 * @brief Compile a GLSL source with glslc.
+	 *
+	 * @param fileName Name of the source file in srcDir.
+	 */
+	void	compileShader(const std::string &fileName);
+};
+
+//**** FUNCTIONS ***************************************************************
+
+#endif
@@ -0,0 +1,365 @@
+#include <engine/shader/SpirvReflection.hpp>
+
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+
+// Subset of SPIR-V specification needed to find descriptors
+# define SPV_MAGIC 0x07230203
+# define SPV_HEADER_SIZE 5
+
+enum SpvOp
+{
+	SPV_OP_ENTRY_POINT = 15,
+	SPV_OP_TYPE_INT = 21,
+	SPV_OP_TYPE_FLOAT = 22,
+	SPV_OP_TYPE_VECTOR = 23,
+	SPV_OP_TYPE_MATRIX = 24,
+	SPV_OP_TYPE_IMAGE = 25,
+	SPV_OP_TYPE_SAMPLER = 26,
+	SPV_OP_TYPE_SAMPLED_IMAGE = 27,
+	SPV_OP_TYPE_ARRAY = 28,
+	SPV_OP_TYPE_RUNTIME_ARRAY = 29,
+	SPV_OP_TYPE_STRUCT = 30,
+	SPV_OP_TYPE_POINTER = 32,
+	SPV_OP_CONSTANT = 43,
+	SPV_OP_VARIABLE = 59,
+	SPV_OP_DECORATE = 71,
+	SPV_OP_MEMBER_DECORATE = 72,
+};
+
+enum SpvDecoration
+{
+	SPV_DECORATION_BLOCK = 2,
+	SPV_DECORATION_BUFFER_BLOCK = 3,
+	SPV_DECORATION_ARRAY_STRIDE = 6,
+	SPV_DECORATION_MATRIX_STRIDE = 7,
+	SPV_DECORATION_BINDING = 33,
+	SPV_DECORATION_DESCRIPTOR_SET = 34,
+	SPV_DECORATION_OFFSET = 35,
+};
+
+enum SpvStorageClass
+{
+	SPV_STORAGE_UNIFORM_CONSTANT = 0,
+	SPV_STORAGE_UNIFORM = 2,
+	SPV_STORAGE_PUSH_CONSTANT = 9,
+	SPV_STORAGE_STORAGE_BUFFER = 12,
+};
+
+enum SpvExecutionModel
+{
+	SPV_MODEL_VERTEX = 0,
+	SPV_MODEL_FRAGMENT = 4,
+	SPV_MODEL_COMPUTE = 5,
+};
+
+
+struct SpvId
+{
+	uint32_t				opcode = 0;
+	// Operands of the instruction after result id
+	std::vector<uint32_t>	operands;
+	int64_t					binding = -1;
+	int64_t					set = -1;
+	uint32_t				arrayStride = 0;
+	bool					block = false;
+	bool					bufferBlock = false;
+	std::vector<uint32_t>	memberOffsets;
+	std::vector<uint32_t>	memberMatrixStrides;
+};
+
+static uint32_t	getTypeSize(
+					std::unordered_map<uint32_t, SpvId> &ids,
+					uint32_t typeId, uint32_t matrixStride);
+
+//**** FUNCTIONS ***************************************************************
+
+ShaderReflection	reflectSpirv(const std::vector<char> &code)
+{
+	if (code.size() % 4 != 0 || code.size() < SPV_HEADER_SIZE * 4)
+		throw std::runtime_error("SPIR-V code size is invalid");
+
+	std::vector<uint32_t>	words(code.size() / 4);
+	memcpy(words.data(), code.data(), code.size());
+	if (words[0] != SPV_MAGIC)
+		throw std::runtime_error("SPIR-V magic number is invalid");
+
+	ShaderReflection						reflection;
+	std::unordered_map<uint32_t, SpvId>		ids;
+	std::vector<uint32_t>					variables;
+
+	reflection.stage = 0;
+	reflection.pushConstantsSize = 0;
+
+	// Collect types, decorations and variables
+	size_t	i = SPV_HEADER_SIZE;
+	while (i < words.size())
+	{
+		uint32_t	opcode = words[i] & 0xffff;
+		uint32_t	nbWords = words[i] >> 16;
+
+		if (nbWords == 0 || i + nbWords > words.size())
+			throw std::runtime_error("SPIR-V instruction is invalid");
+
+		const uint32_t	*ops = &words[i + 1];
+
+		switch (opcode)
+		{
+			case SPV_OP_ENTRY_POINT:
+				if (ops[0] == SPV_MODEL_VERTEX)
+					reflection.stage |= VK_SHADER_STAGE_VERTEX_BIT;
+				else if (ops[0] == SPV_MODEL_FRAGMENT)
+					reflection.stage |= VK_SHADER_STAGE_FRAGMENT_BIT;
+				else if (ops[0] == SPV_MODEL_COMPUTE)
+					reflection.stage |= VK_SHADER_STAGE_COMPUTE_BIT;
+				break;
+
+			case SPV_OP_DECORATE:
+			{
+				SpvId	&id = ids[ops[0]];
+
+				if (ops[1] == SPV_DECORATION_BINDING)
+					id.binding = ops[2];
+				else if (ops[1] == SPV_DECORATION_DESCRIPTOR_SET)
+					id.set = ops[2];
+				else if (ops[1] == SPV_DECORATION_ARRAY_STRIDE)
+					id.arrayStride = ops[2];
+				else if (ops[1] == SPV_DECORATION_BLOCK)
+					id.block = true;
+				else if (ops[1] == SPV_DECORATION_BUFFER_BLOCK)
+					id.bufferBlock = true;
+				break;
+			}
+
+			case SPV_OP_MEMBER_DECORATE:
+			{
+				SpvId		&id = ids[ops[0]];
+				uint32_t	member = ops[1];
+
+				if (ops[2] == SPV_DECORATION_OFFSET)
+				{
+					if (id.memberOffsets.size() <= member)
+						id.memberOffsets.resize(member + 1, 0);
+					id.memberOffsets[member] = ops[3];
+				}
+				else if (ops[2] == SPV_DECORATION_MATRIX_STRIDE)
+				{
+					if (id.memberMatrixStrides.size() <= member)
+						id.memberMatrixStrides.resize(member + 1, 0);
+					id.memberMatrixStrides[member] = ops[3];
+				}
+				break;
+			}
+
+			case SPV_OP_TYPE_INT:
+			case SPV_OP_TYPE_FLOAT:
+			case SPV_OP_TYPE_VECTOR:
+			case SPV_OP_TYPE_MATRIX:
+			case SPV_OP_TYPE_IMAGE:
+			case SPV_OP_TYPE_SAMPLER:
+			case SPV_OP_TYPE_SAMPLED_IMAGE:
+			case SPV_OP_TYPE_ARRAY:
+			case SPV_OP_TYPE_RUNTIME_ARRAY:
+			case SPV_OP_TYPE_STRUCT:
+			case SPV_OP_TYPE_POINTER:
+			{
+				// Result id is the first operand of type instructions
+				SpvId	&id = ids[ops[0]];
+
+				id.opcode = opcode;
+				id.operands.assign(ops + 1, ops + nbWords - 1);
+				break;
+			}
+
+			case SPV_OP_CONSTANT:
+			case SPV_OP_VARIABLE:
+			{
+				// Result type come before result id
+				SpvId	&id = ids[ops[1]];
+
+				id.opcode = opcode;
+				id.operands.assign(ops, ops + nbWords - 1);
+				id.operands.erase(id.operands.begin() + 1);
+				if (opcode == SPV_OP_VARIABLE)
+					variables.push_back(ops[1]);
+				break;
+			}
+
+			default:
+				break;
+		}
+
+		i += nbWords;
+	}
+
+	// Convert interface variables to bindings
+	for (uint32_t variableId : variables)
+	{
+		SpvId		&variable = ids[variableId];
+		uint32_t	storageClass = variable.operands[1];
+
+		if (storageClass != SPV_STORAGE_UNIFORM_CONSTANT && storageClass != SPV_STORAGE_UNIFORM
+			&& storageClass != SPV_STORAGE_PUSH_CONSTANT && storageClass != SPV_STORAGE_STORAGE_BUFFER)
+			continue ;
+
+		// Variable type is a pointer to the resource type
+		uint32_t	typeId = ids[variable.operands[0]].operands[1];
+
+		if (storageClass == SPV_STORAGE_PUSH_CONSTANT)
+		{
+			reflection.pushConstantsSize = getTypeSize(ids, typeId, 0);
+			continue ;
+		}
+
+		// Arrays of resources take many descriptors
+		ReflectedBinding	binding;
+		binding.count = 1;
+		while (ids[typeId].opcode == SPV_OP_TYPE_ARRAY)
+		{
+			binding.count *= ids[ids[typeId].operands[1]].operands[1];
+			typeId = ids[typeId].operands[0];
+		}
+
+		SpvId	&type = ids[typeId];
+
+		binding.set = variable.set < 0 ? 0 : variable.set;
+		binding.binding = variable.binding < 0 ? 0 : variable.binding;
+		binding.stages = reflection.stage;
+		binding.size = 0;
+
+		if (type.opcode == SPV_OP_TYPE_STRUCT)
+		{
+			if (storageClass == SPV_STORAGE_STORAGE_BUFFER || type.bufferBlock)
+				binding.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			else
+				binding.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+			binding.size = getTypeSize(ids, typeId, 0);
+		}
+		else if (type.opcode == SPV_OP_TYPE_SAMPLED_IMAGE)
+			binding.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		else if (type.opcode == SPV_OP_TYPE_SAMPLER)
+			binding.type = VK_DESCRIPTOR_TYPE_SAMPLER;
+		else if (type.opcode == SPV_OP_TYPE_IMAGE)
+		{
+			// Sampled operand is 2 for storage images
+			if (type.operands[5] == 2)
+				binding.type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+			else
+				binding.type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		}
+		else
+			continue ;
+
+		reflection.bindings.push_back(binding);
+	}
+
+	std::sort(reflection.bindings.begin(), reflection.bindings.end(),
+		[](const ReflectedBinding &a, const ReflectedBinding &b)
+		{
+			if (a.set != b.set)
+				return (a.set < b.set);
+			return (a.binding < b.binding);
+		});
+
+	return (reflection);
+}
+
+
+std::vector<ReflectedBinding>	mergeReflections(const std::vector<ShaderReflection> &reflections)
+{
+	std::vector<ReflectedBinding>	bindings;
+
+	for (const ShaderReflection &reflection : reflections)
+	{
+		for (const ReflectedBinding &binding : reflection.bindings)
+		{
+			std::vector<ReflectedBinding>::iterator it = std::find_if(bindings.begin(), bindings.end(),
+				[&binding](const ReflectedBinding &other)
+				{
+					return (other.set == binding.set && other.binding == binding.binding);
+				});
+
+			if (it == bindings.end())
+			{
+				bindings.push_back(binding);
+				continue ;
+			}
+
+			if (it->type != binding.type || it->count != binding.count || it->size != binding.size)
+				throw std::runtime_error("Stages disagree on binding "
+											+ std::to_string(binding.binding));
+			it->stages |= binding.stages;
+		}
+	}
+
+	std::sort(bindings.begin(), bindings.end(),
+		[](const ReflectedBinding &a, const ReflectedBinding &b)
+		{
+			if (a.set != b.set)
+				return (a.set < b.set);
+			return (a.binding < b.binding);
+		});
+
+	return (bindings);
+}
+
+//**** STATIC FUNCTIONS ********************************************************
+
+static uint32_t	getTypeSize(
+					std::unordered_map<uint32_t, SpvId> &ids,
+					uint32_t typeId, uint32_t matrixStride)
+{
+	SpvId	&type = ids[typeId];
+
+	switch (type.opcode)
+	{
+		case SPV_OP_TYPE_INT:
+		case SPV_OP_TYPE_FLOAT:
+			return (type.operands[0] / 8);
+
+		case SPV_OP_TYPE_VECTOR:
+			return (getTypeSize(ids, type.operands[0], 0) * type.operands[1]);
+
+		case SPV_OP_TYPE_MATRIX:
+			// Columns are separated by the stride given on struct member
+			if (matrixStride == 0)
+				matrixStride = getTypeSize(ids, type.operands[0], 0);
+			return (matrixStride * type.operands[1]);
+
+		case SPV_OP_TYPE_ARRAY:
+		{
+			uint32_t	length = ids[type.operands[1]].operands[1];
+			uint32_t	stride = type.arrayStride;
+
+			if (stride == 0)
+				stride = getTypeSize(ids, type.operands[0], matrixStride);
+			return (stride * length);
+		}
+
+		case SPV_OP_TYPE_RUNTIME_ARRAY:
+			return (0);
+
+		case SPV_OP_TYPE_STRUCT:
+		{
+			// Block size end with its last member
+			uint32_t	size = 0;
+			uint32_t	nbMembers = type.operands.size();
+
+			for (uint32_t i = 0; i < nbMembers; i++)
+			{
+				uint32_t	offset = i < type.memberOffsets.size() ? type.memberOffsets[i] : size;
+				uint32_t	stride = i < type.memberMatrixStrides.size() ? type.memberMatrixStrides[i] : 0;
+
+				size = std::max(size, offset + getTypeSize(ids, type.operands[i], stride));
+			}
+			return (size);
+		}
+
+		default:
+			return (0);
+	}
+}
@@ -0,0 +1,56 @@
+#ifndef SPIRV_REFLECTION_HPP
+# define SPIRV_REFLECTION_HPP
+
+# include <define.hpp>
+
+# include <vector>
+
+//**** STRUCTS *****************************************************************
+/**
+ * @brief Descriptor binding found in a SPIR-V module.
+ */
+typedef struct ReflectedBinding_s
+{
+	uint32_t			set;
+	uint32_t			binding;
+	VkDescriptorType	type;
+	uint32_t			count;
+	// Size of the block for buffers, 0 for images and samplers
+	uint32_t			size;
+	VkShaderStageFlags	stages;
+}	ReflectedBinding;
+
+
+/**
+ * @brief Resources used by a SPIR-V module.
+ */
+typedef struct ShaderReflection_s
+{
+	VkShaderStageFlags				stage;
+	std::vector<ReflectedBinding>	bindings;
+	// Size of push constant block, 0 if there is none
+	uint32_t						pushConstantsSize;
+}	ShaderReflection;
+
+//**** FUNCTIONS ***************************************************************
+/**
+ * @brief Read stage, descriptor bindings and push constants of a SPIR-V module.
+ * Uniform blocks are reported as VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER.
+ *
+ * @param code SPIR-V code, as read from a .spv file.
+ *
+ * @return The reflection of the module, bindings sorted by set then binding.
+ * @exception Throw a runtime_error if code isn't a valid SPIR-V module.
+ */
+ShaderReflection	reflectSpirv(const std::vector<char> &code);
+/**
+ * @brief Merge bindings of many stages. Stages of a same binding are combined.
+ *
+ * @param reflections Reflections of each stage of a pipeline.
+ *
+ * @return Bindings of the pipeline, sorted by set then binding.
+ * @exception Throw a runtime_error if stages disagree on a binding type or size.
+ */
+std::vector<ReflectedBinding>	mergeReflections(const std::vector<ShaderReflection> &reflections);
+
+#endif
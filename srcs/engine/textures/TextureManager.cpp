@@ -135,19 +135,28 @@ void	TextureManager::createAllImages(Engine &engine)
 }
 
 
-void	TextureManager::destroyImages(VkDevice device)
+void	TextureManager::destroyImages(VulkanCommandPool &commandPool)
 {
+	std::vector<Image>	oldImages;
 	std::unordered_map<std::string, Image>::iterator it = this->images.begin();
 
 	while (it != this->images.end())
 	{
-		vkDestroySampler(device, it->second.sampler, nullptr);
-		vkDestroyImageView(device, it->second.view, nullptr);
-		vkDestroyImage(device, it->second.image, nullptr);
-		vkFreeMemory(device, it->second.memory, nullptr);
+		oldImages.push_back(it->second);
 		it++;
 	}
 
+	commandPool.getDeletionQueue().push([oldImages](VkDevice device)
+	{
+		for (const Image &image : oldImages)
+		{
+			vkDestroySampler(device, image.sampler, nullptr);
+			vkDestroyImageView(device, image.view, nullptr);
+			vkDestroyImage(device, image.image, nullptr);
+			vkFreeMemory(device, image.memory, nullptr);
+		}
+	});
+
 	this->images.clear();
 }
 
@@ -156,7 +165,7 @@ void	TextureManager::destroyImages(VkDevice device)
 
 void	TextureManager::createTextureImage(
 							VkDevice device, VkPhysicalDevice physicalDevice,
-							const VulkanCommandPool &commandPool,
+							VulkanCommandPool &commandPool,
 							Texture &texture, VkImage &image, VkDeviceMemory &memory)
 {
 	// Create temporary texture buffer
@@ -181,19 +190,10 @@ void	TextureManager::createTextureImage(
 		VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
 		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, memory);
 
-	// Put image into optimize format for copy data in it
-	transitionImageLayout(
-		commandPool, image, VK_FORMAT_R8G8B8A8_SRGB,
-		VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-	// Copy temporary buffet into image
-	copyBufferToImage(commandPool, stagingBuffer, image, static_cast<uint32_t>(texture.width), static_cast<uint32_t>(texture.height));
-	// Put image into optimize format for shader
-	transitionImageLayout(
-		commandPool, image, VK_FORMAT_R8G8B8A8_SRGB,
-		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-	vkDestroyBuffer(device, stagingBuffer, nullptr);
-	vkFreeMemory(device, stagingBufferMemory, nullptr);
+	// Copy temporary buffer into image, and put image into optimize format for shader
+	uploadBufferToImage(commandPool, stagingBuffer, image, static_cast<uint32_t>(texture.width), static_cast<uint32_t>(texture.height));
+
+	releaseStagingBuffer(commandPool, stagingBuffer, stagingBufferMemory);
 }
 
 
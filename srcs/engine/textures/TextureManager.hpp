@@ -105,11 +105,11 @@ public:
 	 */
 	void	createAllImages(Engine &engine);
 	/**
-	 * @brief Free all images created.
+	 * @brief Free all images created, once GPU stop using them.
 	 *
-	 * @param device The device of VulkanContext class.
+	 * @param commandPool The command pool that own deletion queue.
 	 */
-	void	destroyImages(VkDevice device);
+	void	destroyImages(VulkanCommandPool &commandPool);
 
 //**** STATIC METHODS **********************************************************
 
@@ -131,7 +131,7 @@ private:
 	 */
 	void	createTextureImage(
 				VkDevice device, VkPhysicalDevice physicalDevice,
-				const VulkanCommandPool &commandPool,
+				VulkanCommandPool &commandPool,
 				Texture &texture, VkImage &image, VkDeviceMemory &memory);
 	/**
 	 * @brief Create an image view from an image.
@@ -0,0 +1,146 @@
+#include <engine/trace/Trace.hpp>
+
+#ifdef TRACE
+
+# include <chrono>
+# include <fstream>
+# include <iomanip>
+# include <iostream>
+# include <memory>
+# include <mutex>
+# include <stdexcept>
+# include <vector>
+
+//**** STATIC STRUCTS **********************************************************
+
+/**
+ * @brief Struct for events of one thread. Only the owner thread write events,
+ * count is published after the write so readers see complete events.
+ */
+struct TraceBuffer
+{
+	uint32_t				threadId;
+	std::atomic<uint32_t>	nbEvents;
+	std::atomic<uint64_t>	nbDropped;
+	TraceEvent				events[TRACE_BUFFER_SIZE];
+};
+
+//**** STATIC VARIABLES ********************************************************
+
+// Buffers are kept after their thread end, until the export
+static std::mutex								buffersMutex;
+static std::vector<std::unique_ptr<TraceBuffer>>	buffers;
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+
+static TraceBuffer	*getThreadBuffer(void);
+
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+
+TraceScope::TraceScope(const char *name)
+{
+	this->name = name;
+	this->start = traceNow();
+}
+
+//---- Destructor --------------------------------------------------------------
+
+TraceScope::~TraceScope()
+{
+	traceRecord(this->name, this->start, traceNow());
+}
+
+//**** FUNCTIONS ***************************************************************
+
+uint64_t	traceNow(void)
+{
+	return (std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+
+void	traceRecord(const char *name, uint64_t start, uint64_t end)
+{
+	// Buffer is registered once per thread, then writes are lock free
+	static thread_local TraceBuffer	*buffer = getThreadBuffer();
+
+	uint32_t	nbEvents = buffer->nbEvents.load(std::memory_order_relaxed);
+	if (nbEvents >= TRACE_BUFFER_SIZE)
+	{
+		buffer->nbDropped.store(buffer->nbDropped.load(std::memory_order_relaxed) + 1,
+								std::memory_order_relaxed);
+		return ;
+	}
+
+	buffer->events[nbEvents] = {name, start, end};
+	buffer->nbEvents.store(nbEvents + 1, std::memory_order_release);
+}
+
+
+void	traceSave(const std::string &path)
+{
+	std::ofstream	file(path);
+
+	if (!file.is_open())
+		throw std::runtime_error("Can't open trace output " + path);
+
+	std::lock_guard<std::mutex>	lock(buffersMutex);
+	bool						first = true;
+
+	// Complete events, times in microseconds
+	file << std::fixed << std::setprecision(3);
+	file << "{\"traceEvents\": [";
+	for (const std::unique_ptr<TraceBuffer> &buffer : buffers)
+	{
+		uint32_t	nbEvents = buffer->nbEvents.load(std::memory_order_acquire);
+
+		for (uint32_t i = 0; i < nbEvents; i++)
+		{
+			const TraceEvent	&event = buffer->events[i];
+
+			file << (first ? "\n" : ",\n")
+				<< "{\"name\": \"" << event.name << "\", \"ph\": \"X\""
+				<< ", \"ts\": " << event.start / 1000.0
+				<< ", \"dur\": " << (event.end - event.start) / 1000.0
+				<< ", \"pid\": 1, \"tid\": " << buffer->threadId << "}";
+			first = false;
+		}
+
+		// Truncation is visible in the trace, at the end of the thread events
+		uint64_t	nbDropped = buffer->nbDropped.load(std::memory_order_relaxed);
+		if (nbDropped == 0)
+			continue ;
+
+		const TraceEvent	&last = buffer->events[nbEvents - 1];
+
+		file << (first ? "\n" : ",\n")
+			<< "{\"name\": \"dropped events\", \"ph\": \"i\", \"s\": \"t\""
+			<< ", \"ts\": " << last.end / 1000.0
+			<< ", \"pid\": 1, \"tid\": " << buffer->threadId
+			<< ", \"args\": {\"count\": " << nbDropped << "}}";
+		first = false;
+		std::cerr << "Warning : trace thread " << buffer->threadId << " dropped "
+					<< nbDropped << " events, TRACE_BUFFER_SIZE is full" << std::endl;
+	}
+	file << "\n]}\n";
+
+	if (!file.good())
+		throw std::runtime_error("Failed to write trace output " + path);
+}
+
+//**** STATIC FUNCTIONS ********************************************************
+
+static TraceBuffer	*getThreadBuffer(void)
+{
+	std::lock_guard<std::mutex>	lock(buffersMutex);
+
+	buffers.push_back(std::make_unique<TraceBuffer>());
+	buffers.back()->threadId = static_cast<uint32_t>(buffers.size());
+	buffers.back()->nbEvents.store(0, std::memory_order_relaxed);
+	buffers.back()->nbDropped.store(0, std::memory_order_relaxed);
+
+	return (buffers.back().get());
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef TRACE_HPP
+# define TRACE_HPP
+
+# include <defineCore.hpp>
+
+// Scoped CPU timings, exported as Chrome trace json (chrome://tracing, Perfetto).
+// Enabled with meson option trace, else macros compile to nothing.
+# ifdef TRACE
+
+#  include <atomic>
+#  include <cstdint>
+#  include <string>
+
+#  define TRACE_CONCAT_IMPL(a, b) a##b
+#  define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+#  define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#  define TRACE_SAVE(path) traceSave(path)
+
+/**
+ * @brief Struct for a timed scope.
+ */
+struct TraceEvent
+{
+	const char	*name;
+	uint64_t	start;
+	uint64_t	end;
+};
+
+/**
+ * @brief Class for a scope timing, recorded into the buffer of its thread when
+ * destroyed. Use TRACE_SCOPE macro instead.
+ */
+class TraceScope
+{
+public:
+//**** PUBLIC ATTRIBUTS ********************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Contructor of TraceScope class, start the timing.
+	 *
+	 * @param name Name of the scope, must outlive the export (string literal).
+	 */
+	TraceScope(const char *name);
+
+//---- Destructor --------------------------------------------------------------
+	/**
+	 * @brief Destructor of TraceScope class, record the timing.
+	 */
+	~TraceScope();
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+	const char	*name;
+	uint64_t	start;
+};
+
+//**** FUNCTIONS ***************************************************************
+/**
+ * @brief Get the trace clock.
+ *
+ * @return Time in nanoseconds since an arbitrary point.
+ */
+uint64_t	traceNow(void);
+/**
+ * @brief Record a timed scope into the buffer of calling thread. Each thread
+ * write only its own buffer, so there is no lock. Events are dropped once the
+ * buffer is full, they are counted and reported by traceSave.
+ *
+ * @param name Name of the scope.
+ * @param start Start time given by traceNow.
+ * @param end End time given by traceNow.
+ */
+void	traceRecord(const char *name, uint64_t start, uint64_t end);
+/**
+ * @brief Write events of all threads as Chrome trace json. Threads can keep
+ * recording during the write, only events already recorded are written. A
+ * thread that dropped events get an instant event with the count after its
+ * last event, and a warning is printed.
+ *
+ * @param path Path of the file to write.
+ *
+ * @exception Throw an runtime_error if the file can't be written.
+ */
+void	traceSave(const std::string &path);
+
+# else
+
+#  define TRACE_SCOPE(name) ((void)0)
+#  define TRACE_SAVE(path) ((void)0)
+
+# endif
+
+#endif
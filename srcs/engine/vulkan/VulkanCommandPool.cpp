@@ -1,6 +1,7 @@
 #include <engine/vulkan/VulkanCommandPool.hpp>
 
 #include <engine/vulkan/VulkanUtils.hpp>
+#include <engine/trace/Trace.hpp>
 
 #include <stdexcept>
 
@@ -11,10 +12,21 @@
 VulkanCommandPool::VulkanCommandPool(void)
 {
 	this->commandPool = NULL;
+	this->singleTimeCommandPool = NULL;
+	this->singleTimeCommandBuffer = NULL;
+	this->transferCommandPool = NULL;
+	this->graphicsUploadCommandPool = NULL;
+	this->ownershipCommandBuffer = NULL;
+	this->ownershipRecording = false;
+	this->graphicsFamily = 0;
+	this->transferFamily = 0;
+	this->pendingAcquireStages = 0;
+	this->nbThreads = 0;
 	this->copyDevice = NULL;
 	this->copyPhysicalDevice = NULL;
 	this->copySurface = NULL;
 	this->copyGraphicsQueue = NULL;
+	this->copyTransferQueue = NULL;
 }
 
 
@@ -25,6 +37,17 @@ VulkanCommandPool::VulkanCommandPool(VkDevice device, VkPhysicalDevice physicalD
 	this->copyPhysicalDevice = physicalDevice;
 	this->copySurface = surface;
 	this->copyGraphicsQueue = graphicsQueue;
+	this->copyTransferQueue = NULL;
+	this->singleTimeCommandPool = NULL;
+	this->singleTimeCommandBuffer = NULL;
+	this->transferCommandPool = NULL;
+	this->graphicsUploadCommandPool = NULL;
+	this->ownershipCommandBuffer = NULL;
+	this->ownershipRecording = false;
+	this->graphicsFamily = 0;
+	this->transferFamily = 0;
+	this->pendingAcquireStages = 0;
+	this->nbThreads = 0;
 
 	QueueFamilyIndices queueFamilyIndices = findQueueFamilies(physicalDevice, surface);
 
@@ -63,13 +86,58 @@ VkPhysicalDevice	VulkanCommandPool::getCopyPhysicalDevice()
 	return (this->copyPhysicalDevice);
 }
 
+
+bool	VulkanCommandPool::hasTransferQueue(void) const
+{
+	return (this->transferCommandPool != NULL);
+}
+
+
+uint32_t	VulkanCommandPool::getNbThreads(void) const
+{
+	return (this->nbThreads);
+}
+
+
+VulkanTimeline	&VulkanCommandPool::getGraphicsTimeline(void)
+{
+	return (this->graphicsTimeline);
+}
+
+
+const VulkanTimeline	&VulkanCommandPool::getTransferTimeline(void) const
+{
+	return (this->transferTimeline);
+}
+
+
+const VulkanTimeline	&VulkanCommandPool::getUploadTimeline(void) const
+{
+	if (this->transferCommandPool == NULL)
+		return (this->graphicsTimeline);
+	return (this->transferTimeline);
+}
+
+
+VulkanDeletionQueue	&VulkanCommandPool::getDeletionQueue(void)
+{
+	return (this->deletionQueue);
+}
+
+
+VulkanGpuProfiler	&VulkanCommandPool::getGpuProfiler(void)
+{
+	return (this->gpuProfiler);
+}
+
 //---- Setters -----------------------------------------------------------------
 //---- Operators ---------------------------------------------------------------
 //**** PUBLIC METHODS **********************************************************
 //---- Creation ----------------------------------------------------------------
 
 void	VulkanCommandPool::create(VkDevice device, VkPhysicalDevice physicalDevice,
-									VkSurfaceKHR surface, VkQueue graphicsQueue)
+									VkSurfaceKHR surface, VkQueue graphicsQueue,
+									VkQueue transferQueue)
 {
 	if (this->commandPool != NULL)
 		this->destroy(device);
@@ -78,8 +146,10 @@ void	VulkanCommandPool::create(VkDevice device, VkPhysicalDevice physicalDevice,
 	this->copyPhysicalDevice = physicalDevice;
 	this->copySurface = surface;
 	this->copyGraphicsQueue = graphicsQueue;
+	this->copyTransferQueue = transferQueue;
 
 	QueueFamilyIndices queueFamilyIndices = findQueueFamilies(physicalDevice, surface);
+	this->graphicsFamily = queueFamilyIndices.graphicsFamily.value();
 
 	VkCommandPoolCreateInfo poolInfo{};
 	poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -99,12 +169,105 @@ void	VulkanCommandPool::create(VkDevice device, VkPhysicalDevice physicalDevice,
 
 	if (vkAllocateCommandBuffers(device, &allocInfo, this->commandBuffers.data()) != VK_SUCCESS)
 		throw std::runtime_error("Command buffers allocation failed");
+
+	// Single time commands are reset with their pool, no need of reset flag
+	poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+	if (vkCreateCommandPool(device, &poolInfo, nullptr, &this->singleTimeCommandPool) != VK_SUCCESS)
+		throw std::runtime_error("Single time command pool creation failed");
+
+	allocInfo.commandPool = this->singleTimeCommandPool;
+	allocInfo.commandBufferCount = 1;
+	if (vkAllocateCommandBuffers(device, &allocInfo, &this->singleTimeCommandBuffer) != VK_SUCCESS)
+		throw std::runtime_error("Single time command buffer allocation failed");
+
+	this->graphicsTimeline.create(device);
+	this->deletionQueue.setDevice(device);
+	this->gpuProfiler.create(device, physicalDevice, this->graphicsFamily,
+								queueFamilyIndices.transferFamily.value_or(this->graphicsFamily));
+
+	// Uploads are not waited, their buffers are reset one by one once done.
+	// On graphics queue, it's uploads without transfer family, or releases of
+	// buffers written again by transfer queue
+	poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	if (vkCreateCommandPool(device, &poolInfo, nullptr, &this->graphicsUploadCommandPool) != VK_SUCCESS)
+		throw std::runtime_error("Graphics upload command pool creation failed");
+
+	// Without transfer family, uploads stay on graphics queue
+	if (!queueFamilyIndices.transferFamily.has_value())
+		return ;
+
+	this->transferFamily = queueFamilyIndices.transferFamily.value();
+	poolInfo.queueFamilyIndex = this->transferFamily;
+	if (vkCreateCommandPool(device, &poolInfo, nullptr, &this->transferCommandPool) != VK_SUCCESS)
+		throw std::runtime_error("Transfer command pool creation failed");
+
+	this->transferTimeline.create(device);
+}
+
+
+void	VulkanCommandPool::createThreadPools(uint32_t nbThreads)
+{
+	if (this->commandPool == NULL)
+		throw std::runtime_error("No command pool");
+
+	this->destroyThreadPools();
+
+	QueueFamilyIndices queueFamilyIndices = findQueueFamilies(this->copyPhysicalDevice, this->copySurface);
+
+	// Buffers are reset all together with the pool, no need of reset flag
+	VkCommandPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+	poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+
+	this->nbThreads = nbThreads;
+	this->threadPools.resize(MAX_FRAMES_IN_FLIGHT * nbThreads);
+	for (ThreadCommandPool &threadPool : this->threadPools)
+	{
+		threadPool.pool = NULL;
+		threadPool.nbUsed = 0;
+		if (vkCreateCommandPool(this->copyDevice, &poolInfo, nullptr, &threadPool.pool) != VK_SUCCESS)
+			throw std::runtime_error("Thread command pool creation failed");
+	}
 }
 
 //---- Free --------------------------------------------------------------------
 
 void	VulkanCommandPool::destroy(VkDevice device)
 {
+	// GPU is idle here, remaining objects can be destroyed
+	this->deletionQueue.flushAll();
+	this->gpuProfiler.destroy();
+	this->destroyThreadPools();
+	this->graphicsTimeline.destroy();
+	this->transferTimeline.destroy();
+
+	if (this->transferCommandPool != NULL)
+	{
+		vkDestroyCommandPool(device, this->transferCommandPool, nullptr);
+		this->transferCommandPool = NULL;
+	}
+	this->transferCommandBuffers.clear();
+	if (this->graphicsUploadCommandPool != NULL)
+	{
+		vkDestroyCommandPool(device, this->graphicsUploadCommandPool, nullptr);
+		this->graphicsUploadCommandPool = NULL;
+	}
+	this->graphicsUploadCommandBuffers.clear();
+	this->ownershipCommandBuffer = NULL;
+	this->ownershipRecording = false;
+	this->pendingBufferAcquires.clear();
+	this->graphicsBuffers.clear();
+	this->pendingImageAcquires.clear();
+	this->pendingAcquireStages = 0;
+
+	if (this->singleTimeCommandPool != NULL)
+	{
+		vkDestroyCommandPool(device, this->singleTimeCommandPool, nullptr);
+		this->singleTimeCommandPool = NULL;
+		this->singleTimeCommandBuffer = NULL;
+	}
+
 	if (this->commandPool != NULL)
 	{
 		vkDestroyCommandPool(device, this->commandPool, nullptr);
@@ -113,25 +276,20 @@ void	VulkanCommandPool::destroy(VkDevice device)
 		this->copyPhysicalDevice = NULL;
 		this->copySurface = NULL;
 		this->copyGraphicsQueue = NULL;
+		this->copyTransferQueue = NULL;
 	}
 }
 
 //---- Commands ----------------------------------------------------------------
 
-VkCommandBuffer	VulkanCommandPool::beginSingleTimeCommands(void) const
+VkCommandBuffer	VulkanCommandPool::beginSingleTimeCommands(void)
 {
-	if (this->commandPool == NULL)
+	if (this->singleTimeCommandPool == NULL)
 		throw std::runtime_error("No command pool");
 
-	// Allocate command
-	VkCommandBufferAllocateInfo allocInfo{};
-	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-	allocInfo.commandPool = this->commandPool;
-	allocInfo.commandBufferCount = 1;
-
-	VkCommandBuffer commandBuffer;
-	vkAllocateCommandBuffers(this->copyDevice, &allocInfo, &commandBuffer);
+	// Reset previous command, the pool is only used for it
+	VkCommandBuffer commandBuffer = this->singleTimeCommandBuffer;
+	vkResetCommandPool(this->copyDevice, this->singleTimeCommandPool, 0);
 
 	// Prepare command
 	VkCommandBufferBeginInfo beginInfo{};
@@ -144,27 +302,398 @@ VkCommandBuffer	VulkanCommandPool::beginSingleTimeCommands(void) const
 }
 
 
-void	VulkanCommandPool::endSingleTimeCommands(VkCommandBuffer commandBuffer) const
+void	VulkanCommandPool::endSingleTimeCommands(VkCommandBuffer commandBuffer)
 {
-	if (this->commandPool == NULL)
+	if (this->singleTimeCommandPool == NULL)
 		throw std::runtime_error("No command pool");
 
 	vkEndCommandBuffer(commandBuffer);
 
-	// Start command and wait it's execution
+	// Signal cover earlier submits of graphics queue, frames in flight included
+	uint64_t	signalValue = this->submit(this->copyGraphicsQueue, this->graphicsTimeline, commandBuffer);
+	this->graphicsTimeline.wait(signalValue);
+}
+
+
+VkCommandBuffer	VulkanCommandPool::allocateSecondaryCommandBuffer(uint32_t threadId, uint32_t frame)
+{
+	ThreadCommandPool	&threadPool = this->threadPools[frame * this->nbThreads + threadId];
+
+	// Reuse a buffer allocated by a previous frame if possible
+	if (threadPool.nbUsed < threadPool.buffers.size())
+		return (threadPool.buffers[threadPool.nbUsed++]);
+
+	VkCommandBufferAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	allocInfo.commandPool = threadPool.pool;
+	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+	allocInfo.commandBufferCount = 1;
+
+	VkCommandBuffer commandBuffer;
+	if (vkAllocateCommandBuffers(this->copyDevice, &allocInfo, &commandBuffer) != VK_SUCCESS)
+		throw std::runtime_error("Secondary command buffer allocation failed");
+
+	threadPool.buffers.push_back(commandBuffer);
+	threadPool.nbUsed++;
+
+	return (commandBuffer);
+}
+
+
+void	VulkanCommandPool::resetThreadPools(uint32_t frame)
+{
+	for (uint32_t i = 0; i < this->nbThreads; i++)
+	{
+		ThreadCommandPool	&threadPool = this->threadPools[frame * this->nbThreads + i];
+
+		if (threadPool.nbUsed == 0)
+			continue ;
+
+		vkResetCommandPool(this->copyDevice, threadPool.pool, 0);
+		threadPool.nbUsed = 0;
+	}
+}
+
+//---- Transfer ----------------------------------------------------------------
+
+VkCommandBuffer	VulkanCommandPool::beginTransferCommands(void)
+{
+	if (this->graphicsUploadCommandPool == NULL)
+		throw std::runtime_error("No command pool");
+
+	VkCommandBuffer commandBuffer;
+
+	if (this->transferCommandPool == NULL)
+		commandBuffer = this->beginAsyncCommands(this->graphicsUploadCommandPool,
+								this->graphicsUploadCommandBuffers, this->graphicsTimeline);
+	else
+		commandBuffer = this->beginAsyncCommands(this->transferCommandPool,
+								this->transferCommandBuffers, this->transferTimeline);
+	this->gpuProfiler.beginUpload(commandBuffer);
+
+	return (commandBuffer);
+}
+
+
+uint64_t	VulkanCommandPool::endTransferCommands(VkCommandBuffer commandBuffer)
+{
+	TRACE_SCOPE("upload");
+
+	this->gpuProfiler.endUpload(commandBuffer);
+	vkEndCommandBuffer(commandBuffer);
+
+	// Never waited on CPU, next frames are ordered after it on GPU
+	if (this->transferCommandPool == NULL)
+		return (this->submitAsync(this->copyGraphicsQueue, this->graphicsTimeline,
+									this->graphicsUploadCommandBuffers, commandBuffer));
+
+	// Transfer start once graphics queue gave back its buffers
+	uint64_t	graphicsWaitValue = 0;
+	if (this->ownershipRecording)
+		graphicsWaitValue = this->submitOwnershipReleases();
+
+	return (this->submitAsync(this->copyTransferQueue, this->transferTimeline,
+								this->transferCommandBuffers, commandBuffer, graphicsWaitValue));
+}
+
+
+void	VulkanCommandPool::acquireBuffer(
+							VkCommandBuffer commandBuffer, VkBuffer buffer,
+							VkAccessFlags srcAccess, VkPipelineStageFlags srcStage)
+{
+	VkBufferMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	barrier.buffer = buffer;
+	barrier.offset = 0;
+	barrier.size = VK_WHOLE_SIZE;
+
+	// Same queue, copy wait reads of submitted frames before writing
+	if (this->transferCommandPool == NULL)
+	{
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.srcAccessMask = srcAccess;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		vkCmdPipelineBarrier(commandBuffer, srcStage, VK_PIPELINE_STAGE_TRANSFER_BIT,
+								0, 0, nullptr, 1, &barrier, 0, nullptr);
+		return ;
+	}
+
+	// Never given to graphics queue, nothing reads it yet
+	if (this->graphicsBuffers.erase(buffer) == 0)
+		return ;
+
+	if (!this->ownershipRecording)
+	{
+		this->ownershipCommandBuffer = this->beginAsyncCommands(this->graphicsUploadCommandPool,
+											this->graphicsUploadCommandBuffers, this->graphicsTimeline);
+		this->ownershipRecording = true;
+	}
+
+	// A release not yet acquired by graphics queue is completed first
+	for (size_t i = 0; i < this->pendingBufferAcquires.size(); i++)
+	{
+		if (this->pendingBufferAcquires[i].buffer != buffer)
+			continue ;
+
+		vkCmdPipelineBarrier(this->ownershipCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, srcStage,
+								0, 0, nullptr, 1, &this->pendingBufferAcquires[i], 0, nullptr);
+		this->pendingBufferAcquires.erase(this->pendingBufferAcquires.begin() + i);
+		break ;
+	}
+
+	// Release ownership from graphics family, after reads of submitted frames
+	barrier.srcQueueFamilyIndex = this->graphicsFamily;
+	barrier.dstQueueFamilyIndex = this->transferFamily;
+	barrier.srcAccessMask = srcAccess;
+	barrier.dstAccessMask = 0;
+	vkCmdPipelineBarrier(this->ownershipCommandBuffer, srcStage, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+							0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+	// Acquire by transfer queue, submit wait the release
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+							0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+
+void	VulkanCommandPool::releaseBuffer(
+							VkCommandBuffer commandBuffer, VkBuffer buffer,
+							VkAccessFlags dstAccess, VkPipelineStageFlags dstStage)
+{
+	VkBufferMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	barrier.buffer = buffer;
+	barrier.offset = 0;
+	barrier.size = VK_WHOLE_SIZE;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+	// Same queue, a simple barrier is enough
+	if (this->transferCommandPool == NULL)
+	{
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstAccessMask = dstAccess;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage,
+								0, 0, nullptr, 1, &barrier, 0, nullptr);
+		return ;
+	}
+
+	// Release ownership from transfer family
+	barrier.srcQueueFamilyIndex = this->transferFamily;
+	barrier.dstQueueFamilyIndex = this->graphicsFamily;
+	barrier.dstAccessMask = 0;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+							0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+	// Acquire will be done by graphics queue
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = dstAccess;
+	this->pendingBufferAcquires.push_back(barrier);
+	this->pendingAcquireStages |= dstStage;
+	this->graphicsBuffers.insert(buffer);
+}
+
+
+void	VulkanCommandPool::forgetBuffer(VkBuffer buffer)
+{
+	if (buffer == NULL || this->graphicsBuffers.erase(buffer) == 0)
+		return ;
+
+	// An acquire on a destroyed buffer would be invalid
+	for (size_t i = 0; i < this->pendingBufferAcquires.size(); i++)
+	{
+		if (this->pendingBufferAcquires[i].buffer != buffer)
+			continue ;
+
+		this->pendingBufferAcquires.erase(this->pendingBufferAcquires.begin() + i);
+		break ;
+	}
+}
+
+
+void	VulkanCommandPool::releaseImage(
+							VkCommandBuffer commandBuffer, VkImage image,
+							const VkImageSubresourceRange &subresourceRange,
+							VkImageLayout oldLayout, VkImageLayout newLayout,
+							VkAccessFlags dstAccess, VkPipelineStageFlags dstStage)
+{
+	VkImageMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.oldLayout = oldLayout;
+	barrier.newLayout = newLayout;
+	barrier.image = image;
+	barrier.subresourceRange = subresourceRange;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+	// Same queue, a simple layout transition is enough
+	if (this->transferCommandPool == NULL)
+	{
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstAccessMask = dstAccess;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dstStage,
+								0, 0, nullptr, 0, nullptr, 1, &barrier);
+		return ;
+	}
+
+	// Release ownership from transfer family, layout change is done by both sides
+	barrier.srcQueueFamilyIndex = this->transferFamily;
+	barrier.dstQueueFamilyIndex = this->graphicsFamily;
+	barrier.dstAccessMask = 0;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+							0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	// Acquire will be done by graphics queue
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = dstAccess;
+	this->pendingImageAcquires.push_back(barrier);
+	this->pendingAcquireStages |= dstStage;
+}
+
+
+void	VulkanCommandPool::recordPendingAcquires(VkCommandBuffer commandBuffer)
+{
+	if (this->pendingBufferAcquires.empty() && this->pendingImageAcquires.empty())
+		return ;
+
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, this->pendingAcquireStages, 0,
+							0, nullptr,
+							static_cast<uint32_t>(this->pendingBufferAcquires.size()),
+							this->pendingBufferAcquires.data(),
+							static_cast<uint32_t>(this->pendingImageAcquires.size()),
+							this->pendingImageAcquires.data());
+
+	this->pendingBufferAcquires.clear();
+	this->pendingImageAcquires.clear();
+	this->pendingAcquireStages = 0;
+}
+
+//**** STATIC METHODS **********************************************************
+//**** PRIVATE METHODS *********************************************************
+
+uint64_t	VulkanCommandPool::submit(
+								VkQueue queue, VulkanTimeline &timeline,
+								VkCommandBuffer commandBuffer, uint64_t graphicsWaitValue)
+{
+	uint64_t				signalValue = timeline.nextValue();
+	VkSemaphore				signalSemaphore = timeline.getSemaphore();
+	VkSemaphore				waitSemaphore = this->graphicsTimeline.getSemaphore();
+	VkPipelineStageFlags	waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+	VkTimelineSemaphoreSubmitInfo timelineInfo{};
+	timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+	timelineInfo.signalSemaphoreValueCount = 1;
+	timelineInfo.pSignalSemaphoreValues = &signalValue;
+
 	VkSubmitInfo submitInfo{};
 	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.pNext = &timelineInfo;
 	submitInfo.commandBufferCount = 1;
 	submitInfo.pCommandBuffers = &commandBuffer;
+	submitInfo.signalSemaphoreCount = 1;
+	submitInfo.pSignalSemaphores = &signalSemaphore;
 
-	vkQueueSubmit(this->copyGraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-	vkQueueWaitIdle(this->copyGraphicsQueue);
+	if (graphicsWaitValue != 0)
+	{
+		timelineInfo.waitSemaphoreValueCount = 1;
+		timelineInfo.pWaitSemaphoreValues = &graphicsWaitValue;
+		submitInfo.waitSemaphoreCount = 1;
+		submitInfo.pWaitSemaphores = &waitSemaphore;
+		submitInfo.pWaitDstStageMask = &waitStage;
+	}
 
-	// Release command
-	vkFreeCommandBuffers(this->copyDevice, this->commandPool, 1, &commandBuffer);
+	if (vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+		throw std::runtime_error("Command buffer submit failed");
+
+	return (signalValue);
+}
+
+
+VkCommandBuffer	VulkanCommandPool::beginAsyncCommands(
+							VkCommandPool pool, std::vector<AsyncCommandBuffer> &commandBuffers,
+							const VulkanTimeline &timeline)
+{
+	uint64_t		completedValue = timeline.getCompletedValue();
+	VkCommandBuffer	commandBuffer = NULL;
+
+	// Reuse a buffer whose last submit is done, recording ones are never done
+	for (AsyncCommandBuffer &asyncCommandBuffer : commandBuffers)
+	{
+		if (asyncCommandBuffer.value > completedValue)
+			continue ;
+
+		asyncCommandBuffer.value = UINT64_MAX;
+		commandBuffer = asyncCommandBuffer.buffer;
+		break ;
+	}
+
+	if (commandBuffer == NULL)
+	{
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.commandPool = pool;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandBufferCount = 1;
+
+		if (vkAllocateCommandBuffers(this->copyDevice, &allocInfo, &commandBuffer) != VK_SUCCESS)
+			throw std::runtime_error("Upload command buffer allocation failed");
+
+		commandBuffers.push_back({commandBuffer, UINT64_MAX});
+	}
+
+	// Pool allow reset of each buffer, begin reset it
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+	return (commandBuffer);
+}
+
+
+uint64_t	VulkanCommandPool::submitAsync(
+								VkQueue queue, VulkanTimeline &timeline,
+								std::vector<AsyncCommandBuffer> &commandBuffers,
+								VkCommandBuffer commandBuffer, uint64_t graphicsWaitValue)
+{
+	uint64_t	signalValue = this->submit(queue, timeline, commandBuffer, graphicsWaitValue);
+
+	for (AsyncCommandBuffer &asyncCommandBuffer : commandBuffers)
+	{
+		if (asyncCommandBuffer.buffer == commandBuffer)
+			asyncCommandBuffer.value = signalValue;
+	}
+
+	return (signalValue);
+}
+
+
+uint64_t	VulkanCommandPool::submitOwnershipReleases(void)
+{
+	VkCommandBuffer	commandBuffer = this->ownershipCommandBuffer;
+
+	vkEndCommandBuffer(commandBuffer);
+	this->ownershipRecording = false;
+
+	// Not waited here, the transfer submit wait it on GPU
+	return (this->submitAsync(this->copyGraphicsQueue, this->graphicsTimeline,
+								this->graphicsUploadCommandBuffers, commandBuffer));
+}
+
+
+void	VulkanCommandPool::destroyThreadPools(void)
+{
+	for (ThreadCommandPool &threadPool : this->threadPools)
+	{
+		if (threadPool.pool != NULL)
+			vkDestroyCommandPool(this->copyDevice, threadPool.pool, nullptr);
+	}
+	this->threadPools.clear();
+	this->nbThreads = 0;
 }
 
-//**** STATIC METHODS **********************************************************
-//**** PRIVATE METHODS *********************************************************
 //**** FUNCTIONS ***************************************************************
 //**** STATIC FUNCTIONS ********************************************************
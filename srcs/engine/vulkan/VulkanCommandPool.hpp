@@ -2,8 +2,33 @@
 # define VULKAN_COMMAND_POOL_HPP
 
 # include <define.hpp>
+# include <engine/vulkan/VulkanTimeline.hpp>
+# include <engine/vulkan/VulkanDeletionQueue.hpp>
+# include <engine/vulkan/VulkanGpuProfiler.hpp>
 
 # include <vector>
+# include <unordered_set>
+
+/**
+ * @brief Struct for a command pool owned by one thread for one frame.
+ * Secondary command buffers are allocated once and reused after each reset.
+ */
+struct ThreadCommandPool
+{
+	VkCommandPool					pool;
+	std::vector<VkCommandBuffer>	buffers;
+	uint32_t						nbUsed;
+};
+
+/**
+ * @brief Struct for a command buffer submitted without waiting it. It is
+ * reused once its timeline reach the value signaled by its last submit.
+ */
+struct AsyncCommandBuffer
+{
+	VkCommandBuffer	buffer;
+	uint64_t		value;
+};
 
 /**
  * @brief Class for Vulkan command pool.
@@ -61,6 +86,51 @@ public:
 	 * @return The copy of physical device.
 	 */
 	VkPhysicalDevice	getCopyPhysicalDevice();
+	/**
+	 * @brief Get the number of threads that have their own command pools.
+	 *
+	 * @return Number of threads as uint32.
+	 */
+	uint32_t	getNbThreads(void) const;
+	/**
+	 * @brief Know if uploads use a dedicated transfer queue.
+	 *
+	 * @return True if there is a transfer queue, false if uploads use graphics queue.
+	 */
+	bool	hasTransferQueue(void) const;
+	/**
+	 * @brief Getter of graphics timeline, signaled by each graphics submission.
+	 *
+	 * @return Reference to graphics timeline.
+	 */
+	VulkanTimeline	&getGraphicsTimeline(void);
+	/**
+	 * @brief Getter of transfer timeline, signaled by each upload on transfer
+	 * queue. Not created if there is no transfer queue.
+	 *
+	 * @return Reference to transfer timeline.
+	 */
+	const VulkanTimeline	&getTransferTimeline(void) const;
+	/**
+	 * @brief Getter of the timeline signaled by uploads, transfer timeline if
+	 * there is a transfer queue, graphics timeline else. Values returned by
+	 * endTransferCommands are on it.
+	 *
+	 * @return Reference to upload timeline.
+	 */
+	const VulkanTimeline	&getUploadTimeline(void) const;
+	/**
+	 * @brief Getter of deletion queue, flushed with graphics timeline.
+	 *
+	 * @return Reference to deletion queue.
+	 */
+	VulkanDeletionQueue	&getDeletionQueue(void);
+	/**
+	 * @brief Getter of GPU profiler, timing frame scopes and upload batches.
+	 *
+	 * @return Reference to GPU profiler.
+	 */
+	VulkanGpuProfiler	&getGpuProfiler(void);
 
 //---- Setters -----------------------------------------------------------------
 //---- Operators ---------------------------------------------------------------
@@ -74,13 +144,26 @@ public:
  	 * @param physicalDevice The physicalDevice of VulkanContext class.
  	 * @param surface The surface of VulkanContext class.
 	 * @param graphicsQueue The graphics queue to where execute the command.
+	 * @param transferQueue The transfer queue to where execute uploads.
+	 * Ignored if the physical device has no transfer family.
 	 *
 	 * @warning Will destroy the previous command pool if there is one.
 	 * @exception Throw a runtime_error if pool creation failed.
 	 *
 	 */
 	void	create(VkDevice device, VkPhysicalDevice physicalDevice,
-						VkSurfaceKHR surface, VkQueue graphicsQueue);
+						VkSurfaceKHR surface, VkQueue graphicsQueue,
+						VkQueue transferQueue);
+	/**
+	 * @brief Create one command pool per thread and per frame in flight, used
+	 * for record secondary command buffers in parallel.
+	 *
+	 * @param nbThreads Number of threads that will record commands.
+	 *
+	 * @warning Will destroy the previous thread pools if there are some.
+	 * @exception Throw a runtime_error if pool creation failed.
+	 */
+	void	createThreadPools(uint32_t nbThreads);
 
 //---- Free --------------------------------------------------------------------
 	/**
@@ -90,20 +173,127 @@ public:
 
 //---- Commands ----------------------------------------------------------------
 	/**
-	 * @brief Create an empty command.
+	 * @brief Begin the single time command buffer. It is allocated once and
+	 * reset with its pool, so only one can be recorded at a time.
 	 *
 	 * @return The empty command.
 	 * @exception Throw an runtime_error if the command pool is destroy or not create.
 	 */
-	VkCommandBuffer	beginSingleTimeCommands(void) const;
+	VkCommandBuffer	beginSingleTimeCommands(void);
 	/**
-	 * @brief Execute, wait execution and free command.
+	 * @brief Execute and wait execution of command. The graphics timeline
+	 * value it signals also cover every earlier submit on graphics queue, so
+	 * it waits frames in flight too. Only for readbacks and rare setup
+	 * commands, uploads use beginTransferCommands.
 	 *
 	 * @param commandBuffer The command to execute and free.
 	 *
 	 * @exception Throw an runtime_error if the command pool is destroy or not create.
 	 */
-	void	endSingleTimeCommands(VkCommandBuffer commandBuffer) const;
+	void	endSingleTimeCommands(VkCommandBuffer commandBuffer);
+	/**
+	 * @brief Get a secondary command buffer from the pool of a thread for a frame.
+	 * Only the thread threadId can call it for its pools.
+	 *
+	 * @param threadId Id of the thread that will record the command buffer.
+	 * @param frame Index of the frame in flight.
+	 *
+	 * @return A reset secondary command buffer.
+	 * @exception Throw an runtime_error if the allocation failed.
+	 */
+	VkCommandBuffer	allocateSecondaryCommandBuffer(uint32_t threadId, uint32_t frame);
+	/**
+	 * @brief Reset all thread pools of a frame. Must be called once the frame
+	 * is no more used by the GPU.
+	 *
+	 * @param frame Index of the frame in flight.
+	 */
+	void	resetThreadPools(uint32_t frame);
+
+//---- Transfer ----------------------------------------------------------------
+	/**
+	 * @brief Begin an upload command buffer, on transfer queue if there is
+	 * one, on graphics queue else. Buffers are reused once their last upload
+	 * is done, so several uploads can be in flight. Only one can be recorded
+	 * at a time.
+	 *
+	 * @return The empty command.
+	 * @exception Throw an runtime_error if the command pool is destroy or not create.
+	 */
+	VkCommandBuffer	beginTransferCommands(void);
+	/**
+	 * @brief Submit upload command without waiting it. Buffers given back by
+	 * acquireBuffer are released by graphics queue first, the transfer waits
+	 * it on GPU. Next frame submit is ordered after the upload, by waiting
+	 * transfer timeline or by queue order on graphics queue. Staging buffers
+	 * must live until the returned value is reached, the deletion queue does
+	 * it as its next seal is a frame value.
+	 *
+	 * @param commandBuffer The command to execute.
+	 *
+	 * @return The upload timeline value signaled once upload is done.
+	 *
+	 * @exception Throw an runtime_error if the command pool is destroy or not create.
+	 */
+	uint64_t	endTransferCommands(VkCommandBuffer commandBuffer);
+	/**
+	 * @brief Record the acquire of a buffer before transfer commands write it
+	 * again, so reads of frames already submitted are done before the write.
+	 * On a transfer queue, if graphics queue owns it, it is released by
+	 * graphics queue and the transfer waits for this release. On graphics
+	 * queue, a barrier is enough.
+	 *
+	 * @param commandBuffer The transfer command buffer.
+	 * @param buffer The buffer to write.
+	 * @param srcAccess How the buffer is read by graphics queue.
+	 * @param srcStage Where the buffer is read by graphics queue.
+	 */
+	void	acquireBuffer(
+				VkCommandBuffer commandBuffer, VkBuffer buffer,
+				VkAccessFlags srcAccess, VkPipelineStageFlags srcStage);
+	/**
+	 * @brief Record the release of a buffer written by transfer commands. The
+	 * matching acquire is recorded by recordPendingAcquires.
+	 *
+	 * @param commandBuffer The transfer command buffer.
+	 * @param buffer The buffer written.
+	 * @param dstAccess How the buffer will be read by graphics queue.
+	 * @param dstStage Where the buffer will be read by graphics queue.
+	 */
+	void	releaseBuffer(
+				VkCommandBuffer commandBuffer, VkBuffer buffer,
+				VkAccessFlags dstAccess, VkPipelineStageFlags dstStage);
+	/**
+	 * @brief Forget ownership of a buffer about to be destroyed, its pending
+	 * acquire is dropped. Its handle can then be reused by a new buffer.
+	 *
+	 * @param buffer The buffer destroyed.
+	 */
+	void	forgetBuffer(VkBuffer buffer);
+	/**
+	 * @brief Record the release of an image written by transfer commands, with
+	 * a layout change. The matching acquire is recorded by recordPendingAcquires.
+	 *
+	 * @param commandBuffer The transfer command buffer.
+	 * @param image The image written.
+	 * @param subresourceRange The part of image written.
+	 * @param oldLayout The layout of image during transfer.
+	 * @param newLayout The layout of image for graphics queue.
+	 * @param dstAccess How the image will be read by graphics queue.
+	 * @param dstStage Where the image will be read by graphics queue.
+	 */
+	void	releaseImage(
+				VkCommandBuffer commandBuffer, VkImage image,
+				const VkImageSubresourceRange &subresourceRange,
+				VkImageLayout oldLayout, VkImageLayout newLayout,
+				VkAccessFlags dstAccess, VkPipelineStageFlags dstStage);
+	/**
+	 * @brief Record the acquire by graphics queue of all released resources.
+	 * Must be called outside of a render pass, before resources are used.
+	 *
+	 * @param commandBuffer A graphics command buffer.
+	 */
+	void	recordPendingAcquires(VkCommandBuffer commandBuffer);
 
 //**** STATIC METHODS **********************************************************
 
@@ -111,13 +301,102 @@ private:
 //**** PRIVATE ATTRIBUTS *******************************************************
 	VkCommandPool					commandPool;
 	std::vector<VkCommandBuffer>	commandBuffers;
+	VkCommandPool					singleTimeCommandPool;
+	VkCommandBuffer					singleTimeCommandBuffer;
+	VkCommandPool					transferCommandPool;
+	std::vector<AsyncCommandBuffer>	transferCommandBuffers;
+	// Uploads without transfer queue, or graphics side release of buffers
+	// given back to transfer queue
+	VkCommandPool					graphicsUploadCommandPool;
+	std::vector<AsyncCommandBuffer>	graphicsUploadCommandBuffers;
+	VkCommandBuffer					ownershipCommandBuffer;
+	bool							ownershipRecording;
+	uint32_t						graphicsFamily;
+	uint32_t						transferFamily;
+	std::vector<VkBufferMemoryBarrier>	pendingBufferAcquires;
+	// Buffers released to graphics family, acquired or pending
+	std::unordered_set<VkBuffer>	graphicsBuffers;
+	std::vector<VkImageMemoryBarrier>	pendingImageAcquires;
+	VkPipelineStageFlags			pendingAcquireStages;
+	VulkanTimeline					graphicsTimeline;
+	VulkanTimeline					transferTimeline;
+	VulkanDeletionQueue				deletionQueue;
+	VulkanGpuProfiler				gpuProfiler;
+	uint32_t						nbThreads;
+	std::vector<ThreadCommandPool>	threadPools;
 //---- Copy --------------------------------------------------------------------
 	VkDevice						copyDevice;
 	VkPhysicalDevice				copyPhysicalDevice;
 	VkSurfaceKHR					copySurface;
 	VkQueue							copyGraphicsQueue;
+	VkQueue							copyTransferQueue;
 
 //**** PRIVATE METHODS *********************************************************
+	/**
+	 * @brief Submit a command buffer signaling the next value of a timeline,
+	 * without waiting it.
+	 *
+	 * @param queue The queue where submit.
+	 * @param timeline The timeline of the queue.
+	 * @param commandBuffer The command to execute.
+	 * @param graphicsWaitValue Graphics timeline value waited by GPU before
+	 * execution, 0 for none.
+	 *
+	 * @return The timeline value signaled once executed.
+	 *
+	 * @exception Throw an runtime_error if the submit failed.
+	 */
+	uint64_t	submit(
+					VkQueue queue, VulkanTimeline &timeline,
+					VkCommandBuffer commandBuffer, uint64_t graphicsWaitValue = 0);
+	/**
+	 * @brief Begin a command buffer of a pool whose buffers are submitted
+	 * without waiting. A buffer whose last submit is done is reused, else a
+	 * new one is allocated.
+	 *
+	 * @param pool The pool, created with reset command buffer flag.
+	 * @param commandBuffers Buffers allocated from pool.
+	 * @param timeline The timeline signaled by submits of these buffers.
+	 *
+	 * @return The command buffer, in recording state.
+	 *
+	 * @exception Throw an runtime_error if the allocation failed.
+	 */
+	VkCommandBuffer	beginAsyncCommands(
+						VkCommandPool pool, std::vector<AsyncCommandBuffer> &commandBuffers,
+						const VulkanTimeline &timeline);
+	/**
+	 * @brief Submit a command buffer begun by beginAsyncCommands, without
+	 * waiting it.
+	 *
+	 * @param queue The queue where submit.
+	 * @param timeline The timeline of the queue.
+	 * @param commandBuffers Buffers of the pool of commandBuffer.
+	 * @param commandBuffer The command to execute.
+	 * @param graphicsWaitValue Graphics timeline value waited by GPU before
+	 * execution, 0 for none.
+	 *
+	 * @return The timeline value signaled once executed.
+	 *
+	 * @exception Throw an runtime_error if the submit failed.
+	 */
+	uint64_t	submitAsync(
+					VkQueue queue, VulkanTimeline &timeline,
+					std::vector<AsyncCommandBuffer> &commandBuffers,
+					VkCommandBuffer commandBuffer, uint64_t graphicsWaitValue = 0);
+	/**
+	 * @brief Submit graphics side releases recorded by acquireBuffer, without
+	 * waiting them.
+	 *
+	 * @return The graphics timeline value signaled once released.
+	 *
+	 * @exception Throw an runtime_error if the submit failed.
+	 */
+	uint64_t	submitOwnershipReleases(void);
+	/**
+	 * @brief Destroy command pools of threads.
+	 */
+	void	destroyThreadPools(void);
 };
 
 //**** FUNCTIONS ***************************************************************
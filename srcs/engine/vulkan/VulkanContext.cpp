@@ -77,13 +77,19 @@ VkQueue	VulkanContext::getPresentQueue(void) const
 	return (this->presentQueue);
 }
 
+
+VkQueue	VulkanContext::getTransferQueue(void) const
+{
+	return (this->transferQueue);
+}
+
 //---- Setters -----------------------------------------------------------------
 //---- Operators ---------------------------------------------------------------
 //**** PUBLIC METHODS **********************************************************
 
 void	VulkanContext::init(VulkanCommandPool &commandPool, Window &window)
 {
-	this->createInstance();
+	this->createInstance(window);
 	this->setupDebugMessenger();
 
 	window.createSurface(this->instance);
@@ -92,7 +98,8 @@ void	VulkanContext::init(VulkanCommandPool &commandPool, Window &window)
 	this->createLogicalDevice(window);
 
 	commandPool.create(this->device, this->physicalDevice,
-						window.getSurface(), this->graphicsQueue);
+						window.getSurface(), this->graphicsQueue,
+						this->transferQueue);
 
 	window.init(commandPool);
 }
@@ -148,7 +155,7 @@ bool	VulkanContext::checkValidationLayerSupport(void)
 }
 
 
-void	VulkanContext::createInstance(void)
+void	VulkanContext::createInstance(Window &window)
 {
 	// Check validation layer if needed
 	if (enableValidationLayers && !this->checkValidationLayerSupport())
@@ -161,7 +168,8 @@ void	VulkanContext::createInstance(void)
 	appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
 	appInfo.pEngineName = ENGINE_TITLE;
 	appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-	appInfo.apiVersion = VK_API_VERSION_1_0;
+	// 1.2 for timeline semaphores
+	appInfo.apiVersion = VK_API_VERSION_1_2;
 
 	// Device creation info struct
 	VkInstanceCreateInfo createInfo{};
@@ -169,7 +177,7 @@ void	VulkanContext::createInstance(void)
 	createInfo.pApplicationInfo = &appInfo;
 
 	// Get extensions required for device creation
-	std::vector<const char*>	extensions = this->getRequiredExtensions();
+	std::vector<const char*>	extensions = this->getRequiredExtensions(window.isHeadless());
 	createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
 	createInfo.ppEnabledExtensionNames = extensions.data();
 
@@ -225,6 +233,8 @@ void	VulkanContext::createLogicalDevice(Window &window)
 	std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
 	std::set<uint32_t> uniqueQueueFamilies = {QueueIndices.graphicsFamily.value(),
 												QueueIndices.presentFamily.value()};
+	if (QueueIndices.transferFamily.has_value())
+		uniqueQueueFamilies.insert(QueueIndices.transferFamily.value());
 
 	float queuePriority = 1.0f;
 	for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -239,13 +249,33 @@ void	VulkanContext::createLogicalDevice(Window &window)
 	VkPhysicalDeviceFeatures deviceFeatures{};
 	deviceFeatures.samplerAnisotropy = VK_TRUE;
 
+	VkPhysicalDeviceVulkan12Features deviceFeatures12{};
+	deviceFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+	deviceFeatures12.timelineSemaphore = VK_TRUE;
+
+	// Optional, GPU profiler is disabled without it
+	VkPhysicalDeviceVulkan12Features supportedFeatures12{};
+	supportedFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+	VkPhysicalDeviceFeatures2 supportedFeatures{};
+	supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+	supportedFeatures.pNext = &supportedFeatures12;
+	vkGetPhysicalDeviceFeatures2(this->physicalDevice, &supportedFeatures);
+	deviceFeatures12.hostQueryReset = supportedFeatures12.hostQueryReset;
+
 	VkDeviceCreateInfo createInfo{};
 	createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+	createInfo.pNext = &deviceFeatures12;
 	createInfo.pQueueCreateInfos = queueCreateInfos.data();
 	createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 	createInfo.pEnabledFeatures = &deviceFeatures;
-	createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-	createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+	// Headless mode don't present, so don't need swap chain
+	if (window.isHeadless())
+		createInfo.enabledExtensionCount = 0;
+	else
+	{
+		createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
+		createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+	}
 
 	if (enableValidationLayers)
 	{
@@ -261,6 +291,10 @@ void	VulkanContext::createLogicalDevice(Window &window)
 
 	vkGetDeviceQueue(this->device, QueueIndices.graphicsFamily.value(), 0, &this->graphicsQueue);
 	vkGetDeviceQueue(this->device, QueueIndices.presentFamily.value(), 0, &this->presentQueue);
+	if (QueueIndices.transferFamily.has_value())
+		vkGetDeviceQueue(this->device, QueueIndices.transferFamily.value(), 0, &this->transferQueue);
+	else
+		this->transferQueue = this->graphicsQueue;
 }
 
 //---- Utils -------------------------------------------------------------------
@@ -290,13 +324,18 @@ void	VulkanContext::populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreate
 }
 
 
-std::vector<const char*>	VulkanContext::getRequiredExtensions(void)
+std::vector<const char*>	VulkanContext::getRequiredExtensions(bool headless)
 {
-	uint32_t	glfwExtensionCount = 0;
-	const char	**glfwExtensions;
-	glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+	std::vector<const char*> extensions;
 
-	std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	if (!headless)
+	{
+		uint32_t	glfwExtensionCount = 0;
+		const char	**glfwExtensions;
+		glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+
+		extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	}
 
 	if (enableValidationLayers)
 		extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -362,17 +401,30 @@ static bool	checkDeviceExtensionSupport(VkPhysicalDevice physicalDevice)
 static bool	isDeviceSuitable(VkPhysicalDevice device, VkSurfaceKHR surface)
 {
 	QueueFamilyIndices	queueFamilyIndices = findQueueFamilies(device, surface);
-	bool extensionsSupported = checkDeviceExtensionSupport(device);
-	bool swapChainAdequate = false;
+	// Without surface (headless), device don't need to present
+	bool headless = surface == VK_NULL_HANDLE;
+	bool extensionsSupported = headless || checkDeviceExtensionSupport(device);
+	bool swapChainAdequate = headless;
 
-	if (extensionsSupported)
+	if (!headless && extensionsSupported)
 	{
 		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device, surface);
 		swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
 	}
 
-	VkPhysicalDeviceFeatures supportedFeatures;
-	vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(device, &properties);
+	if (properties.apiVersion < VK_API_VERSION_1_2)
+		return (false);
+
+	VkPhysicalDeviceVulkan12Features supportedFeatures12{};
+	supportedFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+	VkPhysicalDeviceFeatures2 supportedFeatures{};
+	supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+	supportedFeatures.pNext = &supportedFeatures12;
+	vkGetPhysicalDeviceFeatures2(device, &supportedFeatures);
 
-	return (queueFamilyIndices.isComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy);
+	return (queueFamilyIndices.isComplete() && extensionsSupported && swapChainAdequate
+			&& supportedFeatures.features.samplerAnisotropy && supportedFeatures12.timelineSemaphore);
 }
@@ -79,6 +79,13 @@ public:
 	 * @return The vulkan present queue.
 	 */
 	VkQueue	getPresentQueue(void) const;
+	/**
+	 * @brief Getter for transfer queue.
+	 *
+	 * @return The vulkan transfer queue, or graphic queue if there is no
+	 * transfer family.
+	 */
+	VkQueue	getTransferQueue(void) const;
 
 //---- Setters -----------------------------------------------------------------
 //---- Operators ---------------------------------------------------------------
@@ -106,7 +113,7 @@ private:
 	VkDebugUtilsMessengerEXT		debugMessenger;
 	VkPhysicalDevice				physicalDevice;
 	VkDevice						device;
-	VkQueue							graphicsQueue, presentQueue;
+	VkQueue							graphicsQueue, presentQueue, transferQueue;
 
 //**** PRIVATE METHODS *********************************************************
 //---- Init sub part -----------------------------------------------------------
@@ -120,8 +127,10 @@ private:
 	 * @brief Create vulkan instance.
 	 *
 	 * The instance is the connection between the projet and vulkan.
+	 *
+	 * @param window The window, glfw extensions are skipped if headless.
 	 */
-	void	createInstance(void);
+	void	createInstance(Window &window);
 	/**
 	 * @brief Find physical device.
 	 */
@@ -143,8 +152,10 @@ private:
 				VkDebugUtilsMessengerCreateInfoEXT& createInfo);
 	/**
 	 * @brief Get requiered extensions.
+	 *
+	 * @param headless If true, extensions needed by glfw surface are skipped.
 	 */
-	std::vector<const char*>	getRequiredExtensions(void);
+	std::vector<const char*>	getRequiredExtensions(bool headless);
 };
 
 #endif
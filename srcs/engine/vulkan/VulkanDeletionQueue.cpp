@@ -0,0 +1,91 @@
+#include <engine/vulkan/VulkanDeletionQueue.hpp>
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+
+VulkanDeletionQueue::VulkanDeletionQueue(void)
+{
+	this->copyDevice = NULL;
+}
+
+//---- Destructor --------------------------------------------------------------
+
+VulkanDeletionQueue::~VulkanDeletionQueue()
+{
+}
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+//---- Setters -----------------------------------------------------------------
+
+void	VulkanDeletionQueue::setDevice(VkDevice device)
+{
+	this->copyDevice = device;
+}
+
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+
+void	VulkanDeletionQueue::push(const Deletion &deletion)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	this->unsealedDeletions.push_back(deletion);
+}
+
+
+void	VulkanDeletionQueue::seal(uint64_t value)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	for (Deletion &deletion : this->unsealedDeletions)
+		this->pendingDeletions.push_back({value, std::move(deletion)});
+	this->unsealedDeletions.clear();
+}
+
+
+void	VulkanDeletionQueue::flush(uint64_t completedValue)
+{
+	std::vector<Deletion>	readyDeletions;
+
+	// Values are sealed in order, so ready deletions are at the front
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		while (!this->pendingDeletions.empty()
+				&& this->pendingDeletions.front().value <= completedValue)
+		{
+			readyDeletions.push_back(std::move(this->pendingDeletions.front().deletion));
+			this->pendingDeletions.pop_front();
+		}
+	}
+
+	for (Deletion &deletion : readyDeletions)
+		deletion(this->copyDevice);
+}
+
+
+void	VulkanDeletionQueue::flushAll(void)
+{
+	std::vector<Deletion>	readyDeletions;
+
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		for (PendingDeletion &pendingDeletion : this->pendingDeletions)
+			readyDeletions.push_back(std::move(pendingDeletion.deletion));
+		for (Deletion &deletion : this->unsealedDeletions)
+			readyDeletions.push_back(std::move(deletion));
+		this->pendingDeletions.clear();
+		this->unsealedDeletions.clear();
+	}
+
+	for (Deletion &deletion : readyDeletions)
+		deletion(this->copyDevice);
+}
+
+//**** STATIC METHODS **********************************************************
+//**** PRIVATE METHODS *********************************************************
+//**** FUNCTIONS ***************************************************************
+//**** STATIC FUNCTIONS ********************************************************
@@ -0,0 +1,102 @@
+#ifndef VULKAN_DELETION_QUEUE_HPP
+# define VULKAN_DELETION_QUEUE_HPP
+
+# include <define.hpp>
+
+# include <deque>
+# include <mutex>
+# include <vector>
+# include <functional>
+
+/**
+ * @brief Function that destroy Vulkan objects. Take the device.
+ */
+using Deletion = std::function<void(VkDevice device)>;
+
+/**
+ * @brief Struct for a deletion waiting the GPU.
+ */
+struct PendingDeletion
+{
+	uint64_t	value;
+	Deletion	deletion;
+};
+
+/**
+ * @brief Class for deferred destruction of Vulkan objects. Objects are pushed
+ * when they are logically dead, and destroyed once the graphics timeline reach
+ * the value of the last frame that could use them.
+ */
+class VulkanDeletionQueue
+{
+public:
+//**** PUBLIC ATTRIBUTS ********************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Default contructor of VulkanDeletionQueue class.
+	 *
+	 * @return The default VulkanDeletionQueue that isn't working.
+	 */
+	VulkanDeletionQueue(void);
+
+//---- Destructor --------------------------------------------------------------
+	/**
+	 * @brief Destructor of VulkanDeletionQueue class.
+	 */
+	~VulkanDeletionQueue();
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+//---- Setters -----------------------------------------------------------------
+	/**
+	 * @brief Setter of device given to deletions.
+	 *
+	 * @param device The device of VulkanContext class.
+	 */
+	void	setDevice(VkDevice device);
+
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+	/**
+	 * @brief Push a deletion. It will wait the end of the next frame submitted,
+	 * because the frame currently recorded can still use the objects.
+	 * Can be called from any thread.
+	 *
+	 * @param deletion Function that destroy the objects.
+	 */
+	void	push(const Deletion &deletion);
+	/**
+	 * @brief Give the timeline value of a submitted frame to all deletions
+	 * pushed before its submit.
+	 *
+	 * @param value The graphics timeline value signaled by the frame.
+	 */
+	void	seal(uint64_t value);
+	/**
+	 * @brief Run deletions whose value is reached by the GPU.
+	 *
+	 * @param completedValue The graphics timeline value reached by the GPU.
+	 */
+	void	flush(uint64_t completedValue);
+	/**
+	 * @brief Run all deletions. GPU must be idle.
+	 */
+	void	flushAll(void);
+
+//**** STATIC METHODS **********************************************************
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+	std::mutex					mutex;
+	std::vector<Deletion>		unsealedDeletions;
+	std::deque<PendingDeletion>	pendingDeletions;
+//---- Copy --------------------------------------------------------------------
+	VkDevice					copyDevice;
+
+//**** PRIVATE METHODS *********************************************************
+};
+
+//**** FUNCTIONS ***************************************************************
+
+#endif
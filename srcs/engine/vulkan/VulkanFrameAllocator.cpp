@@ -0,0 +1,165 @@
+#include <engine/vulkan/VulkanFrameAllocator.hpp>
+
+#include <engine/vulkan/VulkanUtils.hpp>
+
+#include <array>
+#include <stdexcept>
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+
+VulkanFrameAllocator::VulkanFrameAllocator(void)
+{
+	this->uniformAlignment = 1;
+	this->nbResets = 0;
+	this->copyDevice = NULL;
+}
+
+//---- Destructor --------------------------------------------------------------
+
+VulkanFrameAllocator::~VulkanFrameAllocator()
+{
+}
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+
+uint64_t	VulkanFrameAllocator::getNbResets(void) const
+{
+	return (this->nbResets);
+}
+
+
+VkBuffer	VulkanFrameAllocator::getUniformBuffer(uint32_t frame) const
+{
+	return (this->frames[frame].uniformBuffer);
+}
+
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+//---- Creation ----------------------------------------------------------------
+
+void	VulkanFrameAllocator::create(VkDevice device, VkPhysicalDevice physicalDevice)
+{
+	if (this->copyDevice != NULL)
+		this->destroy();
+
+	this->copyDevice = device;
+
+	// Uniform offsets must follow device alignment
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+	this->uniformAlignment = properties.limits.minUniformBufferOffsetAlignment;
+	if (this->uniformAlignment == 0)
+		this->uniformAlignment = 1;
+
+	// Only types accepted by Shader layouts, ubo are always dynamic
+	std::array<VkDescriptorPoolSize, 2> poolSizes{};
+	poolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	poolSizes[0].descriptorCount = FRAME_MAX_DESCRIPTORS;
+	poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	poolSizes[1].descriptorCount = FRAME_MAX_DESCRIPTORS;
+
+	// No free flag, sets are only freed by pool reset
+	VkDescriptorPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+	poolInfo.pPoolSizes = poolSizes.data();
+	poolInfo.maxSets = FRAME_MAX_DESCRIPTOR_SETS;
+
+	this->frames.resize(MAX_FRAMES_IN_FLIGHT);
+	for (FrameResources &frame : this->frames)
+	{
+		frame.descriptorPool = NULL;
+		frame.uniformBuffer = NULL;
+		frame.uniformBufferMemory = NULL;
+		frame.uniformBufferMapped = NULL;
+		frame.uniformOffset = 0;
+
+		if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &frame.descriptorPool) != VK_SUCCESS)
+			throw std::runtime_error("Create frame descriptor pool failed");
+
+		// Uniform buffer stay mapped for all its life
+		createVulkanBuffer(device, physicalDevice,
+							FRAME_UNIFORM_BUFFER_SIZE, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+							VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+							frame.uniformBuffer, frame.uniformBufferMemory);
+		vkMapMemory(device, frame.uniformBufferMemory, 0, FRAME_UNIFORM_BUFFER_SIZE, 0,
+					reinterpret_cast<void **>(&frame.uniformBufferMapped));
+	}
+}
+
+//---- Free --------------------------------------------------------------------
+
+void	VulkanFrameAllocator::destroy(void)
+{
+	if (this->copyDevice == NULL)
+		return ;
+
+	for (FrameResources &frame : this->frames)
+	{
+		if (frame.descriptorPool != NULL)
+			vkDestroyDescriptorPool(this->copyDevice, frame.descriptorPool, nullptr);
+		if (frame.uniformBuffer != NULL)
+			vkDestroyBuffer(this->copyDevice, frame.uniformBuffer, nullptr);
+		if (frame.uniformBufferMemory != NULL)
+			vkFreeMemory(this->copyDevice, frame.uniformBufferMemory, nullptr);
+	}
+	this->frames.clear();
+	this->copyDevice = NULL;
+}
+
+//---- Allocation --------------------------------------------------------------
+
+void	VulkanFrameAllocator::reset(uint32_t frame)
+{
+	FrameResources	&resources = this->frames[frame];
+
+	vkResetDescriptorPool(this->copyDevice, resources.descriptorPool, 0);
+	resources.uniformOffset = 0;
+	this->nbResets++;
+}
+
+
+VkDescriptorSet	VulkanFrameAllocator::allocateDescriptorSet(uint32_t frame, VkDescriptorSetLayout layout)
+{
+	VkDescriptorSetAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocInfo.descriptorPool = this->frames[frame].descriptorPool;
+	allocInfo.descriptorSetCount = 1;
+	allocInfo.pSetLayouts = &layout;
+
+	VkDescriptorSet descriptorSet;
+	if (vkAllocateDescriptorSets(this->copyDevice, &allocInfo, &descriptorSet) != VK_SUCCESS)
+		throw std::runtime_error("Frame descriptor pool is full");
+
+	return (descriptorSet);
+}
+
+
+void	*VulkanFrameAllocator::allocateUniform(uint32_t frame, VkDeviceSize size, VkDescriptorBufferInfo &bufferInfo)
+{
+	FrameResources	&resources = this->frames[frame];
+
+	// Round offset up to alignment
+	VkDeviceSize	offset = (resources.uniformOffset + this->uniformAlignment - 1)
+								/ this->uniformAlignment * this->uniformAlignment;
+
+	if (offset + size > FRAME_UNIFORM_BUFFER_SIZE)
+		throw std::runtime_error("Frame uniform buffer is full");
+
+	resources.uniformOffset = offset + size;
+
+	bufferInfo.buffer = resources.uniformBuffer;
+	bufferInfo.offset = offset;
+	bufferInfo.range = size;
+
+	return (resources.uniformBufferMapped + offset);
+}
+
+//**** STATIC METHODS **********************************************************
+//**** PRIVATE METHODS *********************************************************
+//**** FUNCTIONS ***************************************************************
+//**** STATIC FUNCTIONS ********************************************************
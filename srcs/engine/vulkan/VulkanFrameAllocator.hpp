@@ -0,0 +1,129 @@
+#ifndef VULKAN_FRAME_ALLOCATOR_HPP
+# define VULKAN_FRAME_ALLOCATOR_HPP
+
+# include <define.hpp>
+
+# include <vector>
+
+/**
+ * @brief Struct for transient resources of one frame in flight.
+ */
+struct FrameResources
+{
+	VkDescriptorPool	descriptorPool;
+	VkBuffer			uniformBuffer;
+	VkDeviceMemory		uniformBufferMemory;
+	char				*uniformBufferMapped;
+	VkDeviceSize		uniformOffset;
+};
+
+/**
+ * @brief Class for linear allocation of transient resources of frames.
+ * Allocations are never freed one by one, all resources of a frame are reset
+ * together once its fence signal.
+ */
+class VulkanFrameAllocator
+{
+public:
+//**** PUBLIC ATTRIBUTS ********************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Default contructor of VulkanFrameAllocator class.
+	 *
+	 * @return The default VulkanFrameAllocator that isn't working.
+	 */
+	VulkanFrameAllocator(void);
+
+//---- Destructor --------------------------------------------------------------
+	/**
+	 * @brief Destructor of VulkanFrameAllocator class.
+	 */
+	~VulkanFrameAllocator();
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+	/**
+	 * @brief Get the number of resets done, used to know if an allocation is
+	 * still valid.
+	 *
+	 * @return Number of resets as uint64.
+	 */
+	uint64_t	getNbResets(void) const;
+	/**
+	 * @brief Getter of the uniform buffer of a frame, to bind it as dynamic
+	 * uniform buffer. Allocation offsets are then given at bind.
+	 *
+	 * @param frame Index of the frame in flight.
+	 *
+	 * @return The uniform buffer.
+	 */
+	VkBuffer	getUniformBuffer(uint32_t frame) const;
+
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+//---- Creation ----------------------------------------------------------------
+	/**
+	 * @brief Create descriptor pools and uniform buffers of each frame in flight.
+	 *
+	 * @param device The device of VulkanContext class.
+	 * @param physicalDevice The physicalDevice of VulkanContext class.
+	 *
+	 * @warning Will destroy the previous resources if there are some.
+	 * @exception Throw a runtime_error if a creation failed.
+	 */
+	void	create(VkDevice device, VkPhysicalDevice physicalDevice);
+
+//---- Free --------------------------------------------------------------------
+	/**
+	 * @brief Destroy method for free allocated memory.
+	 */
+	void	destroy(void);
+
+//---- Allocation --------------------------------------------------------------
+	/**
+	 * @brief Free all allocations of a frame. Must be called once the frame
+	 * is no more used by the GPU.
+	 *
+	 * @param frame Index of the frame in flight.
+	 */
+	void	reset(uint32_t frame);
+	/**
+	 * @brief Allocate a descriptor set valid until the next reset of the frame.
+	 *
+	 * @param frame Index of the frame in flight.
+	 * @param layout Layout of the descriptor set.
+	 *
+	 * @return The descriptor set.
+	 * @exception Throw a runtime_error if the frame descriptor pool is full.
+	 */
+	VkDescriptorSet	allocateDescriptorSet(uint32_t frame, VkDescriptorSetLayout layout);
+	/**
+	 * @brief Allocate uniform data valid until the next reset of the frame.
+	 *
+	 * @param frame Index of the frame in flight.
+	 * @param size Size of the data.
+	 * @param bufferInfo Filled with buffer, offset and range of the allocation.
+	 *
+	 * @return Pointer to write the data.
+	 * @exception Throw a runtime_error if the frame uniform buffer is full.
+	 */
+	void	*allocateUniform(uint32_t frame, VkDeviceSize size, VkDescriptorBufferInfo &bufferInfo);
+
+//**** STATIC METHODS **********************************************************
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+	std::vector<FrameResources>	frames;
+	VkDeviceSize				uniformAlignment;
+	uint64_t					nbResets;
+//---- Copy --------------------------------------------------------------------
+	VkDevice					copyDevice;
+
+//**** PRIVATE METHODS *********************************************************
+};
+
+//**** FUNCTIONS ***************************************************************
+
+#endif
@@ -0,0 +1,307 @@
+#include <engine/vulkan/VulkanGpuProfiler.hpp>
+
+#include <stdexcept>
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+
+static uint64_t	getTimestampMask(uint32_t validBits);
+
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+
+VulkanGpuProfiler::VulkanGpuProfiler(void)
+{
+	this->frameQueryPool = NULL;
+	this->uploadQueryPool = NULL;
+	this->timestampPeriod = 0.0;
+	this->graphicsTimestampMask = 0;
+	this->transferTimestampMask = 0;
+	this->recordingUpload = UINT32_MAX;
+	this->currentFrame = 0;
+	this->nbFrames = 0;
+	this->resultsFrame = UINT64_MAX;
+	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+		this->slotFrames[i] = 0;
+	this->copyDevice = NULL;
+}
+
+//---- Destructor --------------------------------------------------------------
+
+VulkanGpuProfiler::~VulkanGpuProfiler()
+{
+}
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+
+bool	VulkanGpuProfiler::isEnabled(void) const
+{
+	return (this->frameQueryPool != NULL);
+}
+
+
+const std::vector<GpuScopeTime>	&VulkanGpuProfiler::getResults(void) const
+{
+	return (this->results);
+}
+
+
+double	VulkanGpuProfiler::getScopeTime(const std::string &name) const
+{
+	for (const GpuScopeTime &result : this->results)
+	{
+		if (name == result.name)
+			return (result.time);
+	}
+	return (0.0);
+}
+
+
+uint64_t	VulkanGpuProfiler::getResultsFrame(void) const
+{
+	return (this->resultsFrame);
+}
+
+
+uint64_t	VulkanGpuProfiler::getNbFrames(void) const
+{
+	return (this->nbFrames);
+}
+
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+
+void	VulkanGpuProfiler::create(VkDevice device, VkPhysicalDevice physicalDevice,
+									uint32_t graphicsFamily, uint32_t transferFamily)
+{
+	this->destroy();
+	this->copyDevice = device;
+
+	// Host reset is enabled by VulkanContext when supported
+	VkPhysicalDeviceVulkan12Features supportedFeatures12{};
+	supportedFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+	VkPhysicalDeviceFeatures2 supportedFeatures{};
+	supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+	supportedFeatures.pNext = &supportedFeatures12;
+	vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures);
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+	this->timestampPeriod = properties.limits.timestampPeriod;
+
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, queueFamilies.data());
+
+	this->graphicsTimestampMask = getTimestampMask(queueFamilies[graphicsFamily].timestampValidBits);
+	this->transferTimestampMask = getTimestampMask(queueFamilies[transferFamily].timestampValidBits);
+
+	if (!supportedFeatures12.hostQueryReset || this->graphicsTimestampMask == 0)
+		return ;
+
+	VkQueryPoolCreateInfo queryPoolInfo{};
+	queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+	// Two timestamps per scope, per frame in flight
+	queryPoolInfo.queryCount = MAX_FRAMES_IN_FLIGHT * GPU_PROFILER_MAX_SCOPES * 2;
+
+	if (vkCreateQueryPool(device, &queryPoolInfo, nullptr, &this->frameQueryPool) != VK_SUCCESS)
+		throw std::runtime_error("Profiler query pool creation failed");
+	vkResetQueryPool(device, this->frameQueryPool, 0, queryPoolInfo.queryCount);
+
+	if (this->transferTimestampMask == 0)
+		return ;
+
+	// Uploads are not waited, each one in flight has its own queries
+	queryPoolInfo.queryCount = GPU_PROFILER_MAX_UPLOADS * 2;
+	if (vkCreateQueryPool(device, &queryPoolInfo, nullptr, &this->uploadQueryPool) != VK_SUCCESS)
+		throw std::runtime_error("Profiler upload query pool creation failed");
+	vkResetQueryPool(device, this->uploadQueryPool, 0, queryPoolInfo.queryCount);
+
+	for (uint32_t i = 0; i < GPU_PROFILER_MAX_UPLOADS; i++)
+		this->freeUploadQueries.push_back(i);
+}
+
+
+void	VulkanGpuProfiler::destroy(void)
+{
+	if (this->frameQueryPool != NULL)
+	{
+		vkDestroyQueryPool(this->copyDevice, this->frameQueryPool, nullptr);
+		this->frameQueryPool = NULL;
+	}
+
+	if (this->uploadQueryPool != NULL)
+	{
+		vkDestroyQueryPool(this->copyDevice, this->uploadQueryPool, nullptr);
+		this->uploadQueryPool = NULL;
+	}
+
+	for (std::vector<const char *> &names : this->scopeNames)
+		names.clear();
+	this->results.clear();
+	this->resultsFrame = UINT64_MAX;
+	this->recordingUpload = UINT32_MAX;
+	this->freeUploadQueries.clear();
+	this->pendingUploads.clear();
+}
+
+
+void	VulkanGpuProfiler::beginFrame(uint32_t frame)
+{
+	this->readFrame(frame);
+
+	this->currentFrame = frame;
+	this->slotFrames[frame] = this->nbFrames;
+	this->nbFrames++;
+}
+
+
+void	VulkanGpuProfiler::readFrame(uint32_t frame)
+{
+	if (this->frameQueryPool == NULL)
+		return ;
+
+	std::vector<const char *>	&names = this->scopeNames[frame];
+	uint32_t					firstQuery = frame * GPU_PROFILER_MAX_SCOPES * 2;
+	uint32_t					nbQueries = static_cast<uint32_t>(names.size()) * 2;
+
+	if (nbQueries == 0)
+		return ;
+
+	// Frame slot is done, results are available without waiting
+	this->timestamps.resize(nbQueries);
+	VkResult result = vkGetQueryPoolResults(
+						this->copyDevice, this->frameQueryPool, firstQuery, nbQueries,
+						nbQueries * sizeof(uint64_t), this->timestamps.data(),
+						sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+
+	if (result == VK_SUCCESS)
+	{
+		this->results.clear();
+		for (size_t i = 0; i < names.size(); i++)
+			this->results.push_back({names[i], this->toMilliseconds(
+										this->timestamps[i * 2], this->timestamps[i * 2 + 1],
+										this->graphicsTimestampMask)});
+		this->results.push_back({"upload", this->readUploads(this->slotFrames[frame])});
+		this->resultsFrame = this->slotFrames[frame];
+	}
+
+	vkResetQueryPool(this->copyDevice, this->frameQueryPool, firstQuery, nbQueries);
+	names.clear();
+}
+
+
+uint32_t	VulkanGpuProfiler::beginScope(VkCommandBuffer commandBuffer, const char *name)
+{
+	std::vector<const char *>	&names = this->scopeNames[this->currentFrame];
+
+	if (this->frameQueryPool == NULL || names.size() >= GPU_PROFILER_MAX_SCOPES)
+		return (UINT32_MAX);
+
+	uint32_t	scopeId = static_cast<uint32_t>(names.size());
+	uint32_t	query = (this->currentFrame * GPU_PROFILER_MAX_SCOPES + scopeId) * 2;
+
+	names.push_back(name);
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+						this->frameQueryPool, query);
+
+	return (scopeId);
+}
+
+
+void	VulkanGpuProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t scopeId)
+{
+	if (scopeId == UINT32_MAX)
+		return ;
+
+	uint32_t	query = (this->currentFrame * GPU_PROFILER_MAX_SCOPES + scopeId) * 2 + 1;
+
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+						this->frameQueryPool, query);
+}
+
+
+void	VulkanGpuProfiler::beginUpload(VkCommandBuffer commandBuffer)
+{
+	this->recordingUpload = UINT32_MAX;
+	if (this->uploadQueryPool == NULL || this->freeUploadQueries.empty())
+		return ;
+
+	this->recordingUpload = this->freeUploadQueries.back();
+	this->freeUploadQueries.pop_back();
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+						this->uploadQueryPool, this->recordingUpload * 2);
+}
+
+
+void	VulkanGpuProfiler::endUpload(VkCommandBuffer commandBuffer)
+{
+	if (this->recordingUpload == UINT32_MAX)
+		return ;
+
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+						this->uploadQueryPool, this->recordingUpload * 2 + 1);
+
+	// Next frame begun is submitted after the upload, and wait it
+	this->pendingUploads.push_back({this->recordingUpload, this->nbFrames});
+	this->recordingUpload = UINT32_MAX;
+}
+
+//**** STATIC METHODS **********************************************************
+//**** PRIVATE METHODS *********************************************************
+
+double	VulkanGpuProfiler::readUploads(uint64_t lastFrame)
+{
+	double	uploadTime = 0.0;
+	size_t	nbPending = 0;
+
+	for (const GpuPendingUpload &upload : this->pendingUploads)
+	{
+		uint64_t	uploadTimestamps[2];
+		VkResult	result = VK_NOT_READY;
+
+		if (upload.frame <= lastFrame)
+			result = vkGetQueryPoolResults(
+						this->copyDevice, this->uploadQueryPool, upload.query * 2, 2,
+						sizeof(uploadTimestamps), uploadTimestamps,
+						sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+
+		// Queries are reset only once GPU is done with them
+		if (result != VK_SUCCESS)
+		{
+			this->pendingUploads[nbPending++] = upload;
+			continue ;
+		}
+
+		uploadTime += this->toMilliseconds(uploadTimestamps[0], uploadTimestamps[1],
+											this->transferTimestampMask);
+		vkResetQueryPool(this->copyDevice, this->uploadQueryPool, upload.query * 2, 2);
+		this->freeUploadQueries.push_back(upload.query);
+	}
+	this->pendingUploads.resize(nbPending);
+
+	return (uploadTime);
+}
+
+
+double	VulkanGpuProfiler::toMilliseconds(uint64_t start, uint64_t end, uint64_t mask) const
+{
+	// Timestamps can wrap on their valid bits
+	uint64_t	ticks = (end - start) & mask;
+
+	return (ticks * this->timestampPeriod / 1000000.0);
+}
+
+//**** FUNCTIONS ***************************************************************
+//**** STATIC FUNCTIONS ********************************************************
+
+static uint64_t	getTimestampMask(uint32_t validBits)
+{
+	if (validBits >= 64)
+		return (UINT64_MAX);
+	return (((uint64_t)1 << validBits) - 1);
+}
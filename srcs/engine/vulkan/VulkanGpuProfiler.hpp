@@ -0,0 +1,205 @@
+#ifndef VULKAN_GPU_PROFILER_HPP
+# define VULKAN_GPU_PROFILER_HPP
+
+# include <define.hpp>
+
+# include <string>
+# include <vector>
+
+/**
+ * @brief Struct for the GPU time of a named scope.
+ */
+struct GpuScopeTime
+{
+	const char	*name;
+	double		time;
+};
+
+/**
+ * @brief Struct for an upload timed by a pair of queries, read back with the
+ * frame that use it.
+ */
+struct GpuPendingUpload
+{
+	uint32_t	query;
+	uint64_t	frame;
+};
+
+/**
+ * @brief Class for GPU timings with timestamp queries. Each frame in flight
+ * has its own queries, read back once the frame slot is reused, so the GPU is
+ * never waited for it. Upload batches are timed on their own queue, and
+ * read back with the first frame submitted after them.
+ * Queries are reset from host, so profiler is disabled without hostQueryReset.
+ */
+class VulkanGpuProfiler
+{
+public:
+//**** PUBLIC ATTRIBUTS ********************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Default contructor of VulkanGpuProfiler class.
+	 *
+	 * @return The default VulkanGpuProfiler that isn't working.
+	 */
+	VulkanGpuProfiler(void);
+
+//---- Destructor --------------------------------------------------------------
+	/**
+	 * @brief Destructor of VulkanGpuProfiler class.
+	 */
+	~VulkanGpuProfiler();
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+	/**
+	 * @brief Getter of profiler state.
+	 *
+	 * @return False if device can't write timestamps on graphics queue.
+	 */
+	bool	isEnabled(void) const;
+	/**
+	 * @brief Getter of scope times of the last frame read back. Frames are
+	 * read back MAX_FRAMES_IN_FLIGHT frames late. Upload batches done before
+	 * the frame are summed in a scope named upload.
+	 *
+	 * @return Scope times in millisecond, in begin order.
+	 */
+	const std::vector<GpuScopeTime>	&getResults(void) const;
+	/**
+	 * @brief Getter of the time of a scope of the last frame read back.
+	 *
+	 * @param name Name of the scope.
+	 *
+	 * @return Time in millisecond, 0 if scope isn't found.
+	 */
+	double	getScopeTime(const std::string &name) const;
+	/**
+	 * @brief Getter of the number of the last frame read back, frames are
+	 * numbered by beginFrame from 0.
+	 *
+	 * @return Frame number, UINT64_MAX if no frame is read back yet.
+	 */
+	uint64_t	getResultsFrame(void) const;
+	/**
+	 * @brief Getter of the number of frames begun.
+	 *
+	 * @return Number of calls to beginFrame.
+	 */
+	uint64_t	getNbFrames(void) const;
+
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+	/**
+	 * @brief Create query pools.
+	 *
+	 * @param device The device of VulkanContext class.
+	 * @param physicalDevice The physicalDevice of VulkanContext class.
+	 * @param graphicsFamily Queue family of frame command buffers.
+	 * @param transferFamily Queue family of upload command buffers.
+	 *
+	 * @exception Throw an runtime_error if a creation failed.
+	 */
+	void	create(VkDevice device, VkPhysicalDevice physicalDevice,
+					uint32_t graphicsFamily, uint32_t transferFamily);
+	/**
+	 * @brief Destroy query pools.
+	 */
+	void	destroy(void);
+	/**
+	 * @brief Read back scopes of the previous use of the frame slot, then reset
+	 * its queries. Must be called once frame slot is no more used by GPU and
+	 * before any scope of the frame.
+	 *
+	 * @param frame The frame slot.
+	 */
+	void	beginFrame(uint32_t frame);
+	/**
+	 * @brief Read back scopes of the frame slot, then reset its queries. Does
+	 * nothing if the slot has no scope. Must be called once frame slot is no
+	 * more used by GPU, beginFrame already does it for every frame but the
+	 * last MAX_FRAMES_IN_FLIGHT ones.
+	 *
+	 * @param frame The frame slot.
+	 */
+	void	readFrame(uint32_t frame);
+	/**
+	 * @brief Write the start timestamp of a scope.
+	 *
+	 * @param commandBuffer Primary command buffer of the frame.
+	 * @param name Name of the scope, must outlive the read back (string literal).
+	 *
+	 * @return Id of the scope, for endScope.
+	 */
+	uint32_t	beginScope(VkCommandBuffer commandBuffer, const char *name);
+	/**
+	 * @brief Write the end timestamp of a scope.
+	 *
+	 * @param commandBuffer Primary command buffer of the frame.
+	 * @param scopeId Id given by beginScope.
+	 */
+	void	endScope(VkCommandBuffer commandBuffer, uint32_t scopeId);
+	/**
+	 * @brief Write the start timestamp of an upload batch. Not timed if
+	 * GPU_PROFILER_MAX_UPLOADS uploads are waiting their read back.
+	 *
+	 * @param commandBuffer Upload command buffer.
+	 */
+	void	beginUpload(VkCommandBuffer commandBuffer);
+	/**
+	 * @brief Write the end timestamp of an upload batch. It is read back with
+	 * the next frame begun, which is submitted after the upload.
+	 *
+	 * @param commandBuffer Upload command buffer.
+	 */
+	void	endUpload(VkCommandBuffer commandBuffer);
+
+//**** STATIC METHODS **********************************************************
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+	VkQueryPool					frameQueryPool;
+	VkQueryPool					uploadQueryPool;
+	double						timestampPeriod;
+	uint64_t					graphicsTimestampMask;
+	uint64_t					transferTimestampMask;
+	uint32_t					recordingUpload;
+	std::vector<uint32_t>		freeUploadQueries;
+	std::vector<GpuPendingUpload>	pendingUploads;
+	uint32_t					currentFrame;
+	uint64_t					nbFrames;
+	uint64_t					resultsFrame;
+	uint64_t					slotFrames[MAX_FRAMES_IN_FLIGHT];
+	std::vector<const char *>	scopeNames[MAX_FRAMES_IN_FLIGHT];
+	std::vector<GpuScopeTime>	results;
+	std::vector<uint64_t>		timestamps;
+//---- Copy --------------------------------------------------------------------
+	VkDevice					copyDevice;
+
+//**** PRIVATE METHODS *********************************************************
+	/**
+	 * @brief Read back uploads of frames up to a frame, then reset their
+	 * queries. The frame must be done on GPU, so are its uploads.
+	 *
+	 * @param lastFrame Number of the last frame whose uploads are read.
+	 *
+	 * @return Sum of upload times in millisecond.
+	 */
+	double	readUploads(uint64_t lastFrame);
+	/**
+	 * @brief Convert two timestamps to a duration.
+	 *
+	 * @param start Start timestamp.
+	 * @param end End timestamp.
+	 * @param mask Mask of valid timestamp bits.
+	 *
+	 * @return Duration in millisecond.
+	 */
+	double	toMilliseconds(uint64_t start, uint64_t end, uint64_t mask) const;
+};
+
+//**** FUNCTIONS ***************************************************************
+
+#endif
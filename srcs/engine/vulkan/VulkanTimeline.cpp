@@ -0,0 +1,110 @@
+#include <engine/vulkan/VulkanTimeline.hpp>
+
+#include <stdexcept>
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+
+VulkanTimeline::VulkanTimeline(void)
+{
+	this->semaphore = NULL;
+	this->lastValue = 0;
+	this->copyDevice = NULL;
+}
+
+//---- Destructor --------------------------------------------------------------
+
+VulkanTimeline::~VulkanTimeline()
+{
+}
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+
+VkSemaphore	VulkanTimeline::getSemaphore(void) const
+{
+	return (this->semaphore);
+}
+
+
+uint64_t	VulkanTimeline::getLastValue(void) const
+{
+	return (this->lastValue);
+}
+
+
+uint64_t	VulkanTimeline::getCompletedValue(void) const
+{
+	uint64_t	value = 0;
+
+	vkGetSemaphoreCounterValue(this->copyDevice, this->semaphore, &value);
+
+	return (value);
+}
+
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+//---- Creation ----------------------------------------------------------------
+
+void	VulkanTimeline::create(VkDevice device)
+{
+	if (this->semaphore != NULL)
+		this->destroy();
+
+	this->copyDevice = device;
+	this->lastValue = 0;
+
+	VkSemaphoreTypeCreateInfo typeInfo{};
+	typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+	typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+	typeInfo.initialValue = 0;
+
+	VkSemaphoreCreateInfo semaphoreInfo{};
+	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	semaphoreInfo.pNext = &typeInfo;
+
+	if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &this->semaphore) != VK_SUCCESS)
+		throw std::runtime_error("Timeline semaphore creation failed");
+}
+
+//---- Free --------------------------------------------------------------------
+
+void	VulkanTimeline::destroy(void)
+{
+	if (this->semaphore != NULL)
+	{
+		vkDestroySemaphore(this->copyDevice, this->semaphore, nullptr);
+		this->semaphore = NULL;
+		this->copyDevice = NULL;
+	}
+}
+
+//---- Synchronisation ---------------------------------------------------------
+
+uint64_t	VulkanTimeline::nextValue(void)
+{
+	this->lastValue++;
+	return (this->lastValue);
+}
+
+
+void	VulkanTimeline::wait(uint64_t value) const
+{
+	// Value 0 is the initial one, nothing to wait
+	if (value == 0)
+		return ;
+
+	VkSemaphoreWaitInfo waitInfo{};
+	waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+	waitInfo.semaphoreCount = 1;
+	waitInfo.pSemaphores = &this->semaphore;
+	waitInfo.pValues = &value;
+
+	if (vkWaitSemaphores(this->copyDevice, &waitInfo, UINT64_MAX) != VK_SUCCESS)
+		throw std::runtime_error("Timeline semaphore wait failed");
+}
+
+//**** FUNCTIONS ***************************************************************
+//**** STATIC FUNCTIONS ********************************************************
@@ -0,0 +1,102 @@
+#ifndef VULKAN_TIMELINE_HPP
+# define VULKAN_TIMELINE_HPP
+
+# include <define.hpp>
+
+/**
+ * @brief Class for a Vulkan timeline semaphore. Each submission signal a new
+ * value, bigger than previous ones, so a resource can be recycled once the
+ * GPU counter reach the value of its last use.
+ */
+class VulkanTimeline
+{
+public:
+//**** PUBLIC ATTRIBUTS ********************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Default contructor of VulkanTimeline class.
+	 *
+	 * @return The default VulkanTimeline that isn't working.
+	 */
+	VulkanTimeline(void);
+
+//---- Destructor --------------------------------------------------------------
+	/**
+	 * @brief Destructor of VulkanTimeline class.
+	 */
+	~VulkanTimeline();
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+	/**
+	 * @brief Getter of semaphore.
+	 *
+	 * @return The timeline semaphore.
+	 */
+	VkSemaphore	getSemaphore(void) const;
+	/**
+	 * @brief Get the last value given by nextValue.
+	 *
+	 * @return The last submitted value as uint64.
+	 */
+	uint64_t	getLastValue(void) const;
+	/**
+	 * @brief Get the value reached by the GPU.
+	 *
+	 * @return The completed value as uint64.
+	 */
+	uint64_t	getCompletedValue(void) const;
+
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+//---- Creation ----------------------------------------------------------------
+	/**
+	 * @brief Create the timeline semaphore, starting at 0.
+	 *
+	 * @param device The device of VulkanContext class.
+	 *
+	 * @warning Will destroy the previous semaphore if there is one.
+	 * @exception Throw a runtime_error if semaphore creation failed.
+	 */
+	void	create(VkDevice device);
+
+//---- Free --------------------------------------------------------------------
+	/**
+	 * @brief Destroy method for free allocated memory.
+	 */
+	void	destroy(void);
+
+//---- Synchronisation ---------------------------------------------------------
+	/**
+	 * @brief Get a new value to signal. Must be called just before the submit
+	 * that signal it, values must be signaled in order.
+	 *
+	 * @return The value to signal.
+	 */
+	uint64_t	nextValue(void);
+	/**
+	 * @brief Wait until the GPU reach a value.
+	 *
+	 * @param value The value to wait.
+	 *
+	 * @exception Throw a runtime_error if the wait failed.
+	 */
+	void	wait(uint64_t value) const;
+
+//**** STATIC METHODS **********************************************************
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+	VkSemaphore	semaphore;
+	uint64_t	lastValue;
+//---- Copy --------------------------------------------------------------------
+	VkDevice	copyDevice;
+
+//**** PRIVATE METHODS *********************************************************
+};
+
+//**** FUNCTIONS ***************************************************************
+
+#endif
@@ -32,6 +32,7 @@ uint32_t	findMemoryType(
 QueueFamilyIndices	findQueueFamilies(VkPhysicalDevice physicalDevice, VkSurfaceKHR surface)
 {
 	QueueFamilyIndices	queueFamilyIndices;
+	bool				transferOnlyFound = false;
 
 	uint32_t queueFamilyCount = 0;
 	vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &queueFamilyCount, nullptr);
@@ -42,20 +43,39 @@ QueueFamilyIndices	findQueueFamilies(VkPhysicalDevice physicalDevice, VkSurfaceK
 	int i = 0;
 	for (const auto &queueFamily : queueFamilies)
 	{
-		if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
+		if (!queueFamilyIndices.graphicsFamily.has_value()
+			&& (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT))
 			queueFamilyIndices.graphicsFamily = i;
 
-		if (queueFamilyIndices.isComplete())
-			break;
-
-		VkBool32 presentSupport = false;
-		vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
-		if (presentSupport)
-			queueFamilyIndices.presentFamily = i;
+		if (!queueFamilyIndices.presentFamily.has_value() && surface != VK_NULL_HANDLE)
+		{
+			VkBool32 presentSupport = false;
+			vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, i, surface, &presentSupport);
+			if (presentSupport)
+				queueFamilyIndices.presentFamily = i;
+		}
+
+		// Prefer transfer only family (copy engine) over async compute one
+		if ((queueFamily.queueFlags & VK_QUEUE_TRANSFER_BIT)
+			&& !(queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT))
+		{
+			bool	isTransferOnly = !(queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT);
+
+			if (!queueFamilyIndices.transferFamily.has_value()
+				|| (isTransferOnly && !transferOnlyFound))
+			{
+				queueFamilyIndices.transferFamily = i;
+				transferOnlyFound = isTransferOnly;
+			}
+		}
 
 		i++;
 	}
 
+	// Without surface nothing is presented, present queue is graphics one
+	if (surface == VK_NULL_HANDLE)
+		queueFamilyIndices.presentFamily = queueFamilyIndices.graphicsFamily;
+
 	return (queueFamilyIndices);
 }
 
@@ -232,25 +252,46 @@ VkImageView	createVulkanImageView(
 
 //---- Copies ------------------------------------------------------------------
 
-void	copyBuffer(
-			const VulkanCommandPool &commandPool,
+uint64_t	copyBuffer(
+			VulkanCommandPool &commandPool,
 			VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
 {
-	VkCommandBuffer commandBuffer = commandPool.beginSingleTimeCommands();
-
 	// Define copy region
 	VkBufferCopy copyRegion{};
 	copyRegion.srcOffset = 0; // Optional
 	copyRegion.dstOffset = 0; // Optional
 	copyRegion.size = size;
-	vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
 
-	commandPool.endSingleTimeCommands(commandBuffer);
+	return (copyBufferRegions(commandPool, srcBuffer, dstBuffer, {copyRegion}));
+}
+
+
+uint64_t	copyBufferRegions(
+			VulkanCommandPool &commandPool,
+			VkBuffer srcBuffer, VkBuffer dstBuffer,
+			const std::vector<VkBufferCopy> &regions)
+{
+	VkCommandBuffer commandBuffer = commandPool.beginTransferCommands();
+
+	// Take buffer back from graphics queue if it was uploaded before
+	commandPool.acquireBuffer(commandBuffer, dstBuffer,
+								VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT,
+								VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+
+	vkCmdCopyBuffer(commandBuffer, srcBuffer, dstBuffer,
+					static_cast<uint32_t>(regions.size()), regions.data());
+
+	// Give buffer to graphics queue for vertex input
+	commandPool.releaseBuffer(commandBuffer, dstBuffer,
+								VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT,
+								VK_PIPELINE_STAGE_VERTEX_INPUT_BIT);
+
+	return (commandPool.endTransferCommands(commandBuffer));
 }
 
 
 void	copyBufferToImage(
-			const VulkanCommandPool &commandPool,
+			VulkanCommandPool &commandPool,
 			VkBuffer buffer, VkImage image, uint32_t width, uint32_t height)
 {
 	VkCommandBuffer commandBuffer = commandPool.beginSingleTimeCommands();
@@ -279,10 +320,82 @@ void	copyBufferToImage(
 	commandPool.endSingleTimeCommands(commandBuffer);
 }
 
+
+uint64_t	uploadBufferToImage(
+			VulkanCommandPool &commandPool,
+			VkBuffer buffer, VkImage image, uint32_t width, uint32_t height)
+{
+	VkCommandBuffer commandBuffer = commandPool.beginTransferCommands();
+
+	VkImageSubresourceRange	subresourceRange{};
+	subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	subresourceRange.baseMipLevel = 0;
+	subresourceRange.levelCount = 1;
+	subresourceRange.baseArrayLayer = 0;
+	subresourceRange.layerCount = 1;
+
+	// Put image into optimize format for copy data in it
+	VkImageMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image = image;
+	barrier.subresourceRange = subresourceRange;
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+							0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	// Define copy region
+	VkBufferImageCopy region{};
+	region.bufferOffset = 0;
+	region.bufferRowLength = 0;
+	region.bufferImageHeight = 0;
+
+	region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	region.imageSubresource.mipLevel = 0;
+	region.imageSubresource.baseArrayLayer = 0;
+	region.imageSubresource.layerCount = 1;
+
+	region.imageOffset = {0, 0, 0};
+	region.imageExtent = {
+		width,
+		height,
+		1
+	};
+
+	// Copy command
+	vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+	// Put image into optimize format for shader and give it to graphics queue
+	commandPool.releaseImage(commandBuffer, image, subresourceRange,
+								VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+								VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+								VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+	return (commandPool.endTransferCommands(commandBuffer));
+}
+
+
+void	releaseStagingBuffer(
+			VulkanCommandPool &commandPool,
+			VkBuffer buffer, VkDeviceMemory memory)
+{
+	// Next seal is a frame value, that frame is ordered after the upload
+	commandPool.getDeletionQueue().push([buffer, memory](VkDevice device)
+	{
+		vkDestroyBuffer(device, buffer, nullptr);
+		vkFreeMemory(device, memory, nullptr);
+	});
+}
+
 //---- Others ------------------------------------------------------------------
 
 void	transitionImageLayout(
-			const VulkanCommandPool &commandPool,
+			VulkanCommandPool &commandPool,
 			VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout)
 {
 	VkCommandBuffer commandBuffer = commandPool.beginSingleTimeCommands();
@@ -5,12 +5,15 @@
 # include <engine/vulkan/VulkanCommandPool.hpp>
 
 # include <optional>
+# include <vector>
 
 //**** STRUCTS *****************************************************************
 typedef struct QueueFamilyIndices_s
 {
 	std::optional<uint32_t>	graphicsFamily;
 	std::optional<uint32_t>	presentFamily;
+	// Only set if a family other than graphics one can do transfers
+	std::optional<uint32_t>	transferFamily;
 
 	bool	isComplete(void)
 	{
@@ -43,7 +46,8 @@ uint32_t	findMemoryType(
 				VkPhysicalDevice physicalDevice,
 				uint32_t typeFilter, VkMemoryPropertyFlags properties);
 /**
- * @brief Find queue families.
+ * @brief Find queue families. A transfer only family is preferred for
+ * transfer family, then any family without graphics.
  *
  * @param physicalDevice The physicalDevice of VulkanContext class.
  * @param surface The surface of VulkanContext class.
@@ -149,16 +153,34 @@ VkImageView	createVulkanImageView(
 
 //---- Copies ------------------------------------------------------------------
 /**
- * @brief Copy srcBuffer to dstBuffer.
+ * @brief Copy srcBuffer to dstBuffer, on transfer queue if there is one.
+ * dstBuffer must be a vertex or index buffer.
  *
  * @param commandPool The command pool for run the copy.
  * @param srcBuffer The buffer that will be copied.
  * @param dstBuffer Where the buffer will be copied.
  * @param size The size of buffer that will be copied. Can be smaller thant srcBuffer size for copy only a part.
+ *
+ * @return Upload timeline value signaled once copied, srcBuffer must live until then.
  */
-void	copyBuffer(
-			const VulkanCommandPool &commandPool,
+uint64_t	copyBuffer(
+			VulkanCommandPool &commandPool,
 			VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
+/**
+ * @brief Copy regions of srcBuffer to dstBuffer in one command, on transfer
+ * queue if there is one. dstBuffer must be a vertex or index buffer.
+ *
+ * @param commandPool The command pool for run the copy.
+ * @param srcBuffer The buffer that will be copied.
+ * @param dstBuffer Where the buffer will be copied.
+ * @param regions Offsets and sizes of parts to copy.
+ *
+ * @return Upload timeline value signaled once copied, srcBuffer must live until then.
+ */
+uint64_t	copyBufferRegions(
+			VulkanCommandPool &commandPool,
+			VkBuffer srcBuffer, VkBuffer dstBuffer,
+			const std::vector<VkBufferCopy> &regions);
 /**
  * @brief Copy buffer to image.
  *
@@ -169,8 +191,34 @@ void	copyBuffer(
  * @param height Height of image.
  */
 void	copyBufferToImage(
-			const VulkanCommandPool &commandPool,
+			VulkanCommandPool &commandPool,
+			VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
+/**
+ * @brief Upload buffer into a new color image, on transfer queue if there is one.
+ * The image goes from undefined layout to shader read only layout.
+ *
+ * @param commandPool The command pool for run the upload.
+ * @param buffer The buffer that will be copied.
+ * @param image Image where the buffer will be copied.
+ * @param width Width of image.
+ * @param height Height of image.
+ *
+ * @return Upload timeline value signaled once copied, buffer must live until then.
+ */
+uint64_t	uploadBufferToImage(
+			VulkanCommandPool &commandPool,
 			VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
+/**
+ * @brief Give a staging buffer to deletion queue, it is destroyed once the
+ * frames submitted after its upload are done.
+ *
+ * @param commandPool The command pool used for the upload.
+ * @param buffer The staging buffer.
+ * @param memory Memory of staging buffer.
+ */
+void	releaseStagingBuffer(
+			VulkanCommandPool &commandPool,
+			VkBuffer buffer, VkDeviceMemory memory);
 
 //---- Others ------------------------------------------------------------------
 /**
@@ -183,7 +231,7 @@ void	copyBufferToImage(
  * @param newLayout The new layout wanted for image.
  */
 void	transitionImageLayout(
-			const VulkanCommandPool &commandPool,
+			VulkanCommandPool &commandPool,
 			VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout);
 
 #endif
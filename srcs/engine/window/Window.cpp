@@ -2,8 +2,12 @@
 
 #include <engine/shader/Shader.hpp>
 #include <engine/vulkan/VulkanContext.hpp>
+#include <engine/trace/Trace.hpp>
 
 #include <array>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 
 //**** STATIC VARIABLES ********************************************************
 
@@ -16,25 +20,38 @@ static void	framebufferResizeCallback(GLFWwindow* window, int width, int height)
 //**** INITIALISION ************************************************************
 //---- Constructors ------------------------------------------------------------
 
-Window::Window(void)
+Window::Window(void) : Window(false)
+{
+}
+
+
+Window::Window(bool headless)
 {
 	// Init window variables
 	this->window = NULL;
 	this->size = gm::Vec2i(WIN_W, WIN_H);
 	this->title = WIN_TITLE;
+	this->headless = headless;
 
-	// Create window
-	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-	glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
-	this->window = glfwCreateWindow(this->size.x, this->size.y,
-										this->title.c_str(), nullptr, nullptr);
-	if (window == NULL)
-		throw std::runtime_error("GLFW window creation failed");
-
-	// Window resize handler
-	glfwSetFramebufferSizeCallback(this->window, framebufferResizeCallback);
+	// Create window, headless mode render without it
+	if (!this->headless)
+	{
+		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+		glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+		this->window = glfwCreateWindow(this->size.x, this->size.y,
+											this->title.c_str(), nullptr, nullptr);
+		if (window == NULL)
+			throw std::runtime_error("GLFW window creation failed");
+
+		// Window resize handler
+		glfwSetFramebufferSizeCallback(this->window, framebufferResizeCallback);
+	}
 
 	// Init vulkan variables
+	this->imageIndex = 0;
+	this->lastImageIndex = 0;
+	this->frameStats = {0, 0};
+	this->frameGpuScope = UINT32_MAX;
 	this->currentFrame = 0;
 	this->surface = NULL;
 	this->swapChain = NULL;
@@ -48,6 +65,7 @@ Window::Window(void)
 	this->copyPhysicalDevice = NULL;
 	this->copyCommandPool = NULL;
 	this->copyCommandBuffers = NULL;
+	this->copyJobPool = NULL;
 }
 
 
@@ -57,6 +75,7 @@ Window::Window(const Window &obj)
 	this->window = NULL;
 	this->size = obj.size;
 	this->title = obj.title;
+	this->headless = false;
 
 	// Create window
 	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
@@ -70,6 +89,10 @@ Window::Window(const Window &obj)
 	glfwSetFramebufferSizeCallback(this->window, framebufferResizeCallback);
 
 	// Init vulkan variables
+	this->imageIndex = 0;
+	this->lastImageIndex = 0;
+	this->frameStats = {0, 0};
+	this->frameGpuScope = UINT32_MAX;
 	this->currentFrame = 0;
 	this->surface = NULL;
 	this->swapChain = NULL;
@@ -83,6 +106,7 @@ Window::Window(const Window &obj)
 	this->copyPhysicalDevice = NULL;
 	this->copyCommandPool = NULL;
 	this->copyCommandBuffers = NULL;
+	this->copyJobPool = NULL;
 }
 
 //---- Destructor --------------------------------------------------------------
@@ -108,6 +132,12 @@ VkSurfaceKHR	Window::getSurface(void) const
 }
 
 
+bool	Window::isHeadless(void) const
+{
+	return (this->headless);
+}
+
+
 VkRenderPass	Window::getRenderPass(void)
 {
 	return (this->renderPass);
@@ -120,6 +150,12 @@ uint32_t	Window::getCurrentFrame(void)
 }
 
 
+VulkanFrameAllocator	&Window::getFrameAllocator(void)
+{
+	return (this->frameAllocator);
+}
+
+
 const gm::Vec2i	&Window::getSize(void) const
 {
 	return (this->size);
@@ -131,12 +167,19 @@ const std::string	&Window::getTitle(void) const
 	return (this->title);
 }
 
+
+const FrameStats	&Window::getFrameStats(void) const
+{
+	return (this->frameStats);
+}
+
 //---- Setters -----------------------------------------------------------------
 
 void	Window::setSize(const gm::Vec2i &size)
 {
 	this->size = size;
-	glfwSetWindowSize(this->window, this->size.x, this->size.y);
+	if (this->window != NULL)
+		glfwSetWindowSize(this->window, this->size.x, this->size.y);
 	this->recreateSwapChain();
 }
 
@@ -144,7 +187,14 @@ void	Window::setSize(const gm::Vec2i &size)
 void	Window::setTitle(const std::string &title)
 {
 	this->title = title;
-	glfwSetWindowTitle(this->window, this->title.c_str());
+	if (this->window != NULL)
+		glfwSetWindowTitle(this->window, this->title.c_str());
+}
+
+
+void	Window::setJobPool(JobPool &jobPool)
+{
+	this->copyJobPool = &jobPool;
 }
 
 //---- Operators ---------------------------------------------------------------
@@ -165,6 +215,9 @@ Window	&Window::operator=(const Window &obj)
 
 void	Window::createSurface(VkInstance instance)
 {
+	if (this->headless)
+		return ;
+
 	if (glfwCreateWindowSurface(instance, this->window, nullptr, &this->surface) != VK_SUCCESS)
 		throw std::runtime_error("Surface creation failed");
 }
@@ -183,6 +236,7 @@ void	Window::init(VulkanCommandPool &commandPool)
 	this->createRenderPass();
 	this->createDepthResources();
 	this->createFramebuffers();
+	this->frameAllocator.create(this->copyDevice, this->copyPhysicalDevice);
 }
 
 
@@ -191,23 +245,26 @@ void	Window::recreateSwapChain(void)
 	if (this->copyDevice == NULL)
 		return ;
 
-	int	width = 0;
-	int	height = 0;
-
-	// Get window size
-	glfwGetFramebufferSize(this->window, &width, &height);
-	// If size if 0, keep asking size
-	while (width == 0 || height == 0)
+	// Headless size is only changed by setSize
+	if (this->window != NULL)
 	{
+		int	width = 0;
+		int	height = 0;
+
+		// Get window size
 		glfwGetFramebufferSize(this->window, &width, &height);
-		glfwWaitEvents();
+		// If size if 0, keep asking size
+		while (width == 0 || height == 0)
+		{
+			glfwGetFramebufferSize(this->window, &width, &height);
+			glfwWaitEvents();
+		}
+
+		this->size = gm::Vec2i(width, height);
 	}
 
-	this->size = gm::Vec2i(width, height);
-
-	vkDeviceWaitIdle(this->copyDevice);
-
-	this->destroySwapChain();
+	// Frames in flight can still use old swap chain, so it's destroyed later
+	this->retireSwapChain();
 
 	this->createSwapChain();
 	this->createImageViews();
@@ -222,6 +279,9 @@ void	Window::destroy(VkInstance instance)
 	// Free swap chain
 	this->destroySwapChain();
 
+	// Free frames transient allocations
+	this->frameAllocator.destroy();
+
 	// Free render pass
 	if (this->renderPass != NULL)
 		vkDestroyRenderPass(this->copyDevice, this->renderPass, nullptr);
@@ -234,9 +294,6 @@ void	Window::destroy(VkInstance instance)
 
 		if (this->imageAvailableSemaphores[i] != NULL)
 			vkDestroySemaphore(this->copyDevice, this->imageAvailableSemaphores[i], nullptr);
-
-		if (this->inFlightFences[i] != NULL)
-			vkDestroyFence(this->copyDevice, this->inFlightFences[i], nullptr);
 	}
 
 	// Free surface
@@ -247,54 +304,200 @@ void	Window::destroy(VkInstance instance)
 
 //---- Draw --------------------------------------------------------------------
 
-void	Window::startDraw(void)
+bool	Window::beginFrame(void)
 {
-	// Wait the end of render of previous frame
-	vkWaitForFences(this->copyDevice, 1, &this->inFlightFences[this->currentFrame], VK_TRUE, UINT64_MAX);
+	// Wait the end of render of the previous use of this frame
+	VulkanTimeline &graphicsTimeline = this->copyCommandPool->getGraphicsTimeline();
+	{
+		TRACE_SCOPE("frame wait");
+		graphicsTimeline.wait(this->frameTimelineValues[this->currentFrame]);
+	}
 
-	// Get an image from swap chain
-	VkResult result = vkAcquireNextImageKHR(this->copyDevice, this->swapChain, UINT64_MAX, this->imageAvailableSemaphores[this->currentFrame], VK_NULL_HANDLE, &this->imageIndex);
+	// Destroy objects that GPU stop using
+	this->copyCommandPool->getDeletionQueue().flush(graphicsTimeline.getCompletedValue());
 
-	// Check if we need to recreate swap chain (because window size change)
-	if (result == VK_ERROR_OUT_OF_DATE_KHR)
+	if (this->headless)
 	{
-		this->recreateSwapChain();
-		return;
+		// One offscreen image per frame, already free after timeline wait
+		this->imageIndex = this->currentFrame;
+	}
+	else
+	{
+		// Get an image from swap chain
+		VkResult result = vkAcquireNextImageKHR(this->copyDevice, this->swapChain, UINT64_MAX, this->imageAvailableSemaphores[this->currentFrame], VK_NULL_HANDLE, &this->imageIndex);
+
+		// Check if we need to recreate swap chain (because window size change)
+		if (result == VK_ERROR_OUT_OF_DATE_KHR)
+		{
+			this->recreateSwapChain();
+			return (false);
+		}
+		else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+			throw std::runtime_error("Swap chain image aquisition failed");
 	}
-	else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
-		throw std::runtime_error("Swap chain image aquisition failed");
 
-	// Reset the fence only if we will use it (avoid deadlock when recreate swap chain)
-	vkResetFences(this->copyDevice, 1, &this->inFlightFences[this->currentFrame]);
+	// Transient allocations of this frame are no more used by GPU
+	this->copyCommandPool->resetThreadPools(this->currentFrame);
+	this->frameAllocator.reset(this->currentFrame);
 
 	this->copyCommandBuffers = this->copyCommandPool->getCommandBuffers().data();
-	vkResetCommandBuffer(this->copyCommandBuffers[this->currentFrame], 0);
+	VkCommandBuffer commandBuffer = this->copyCommandBuffers[this->currentFrame];
+	vkResetCommandBuffer(commandBuffer, 0);
+
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	beginInfo.pInheritanceInfo = nullptr; // Optional
+
+	if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+		throw std::runtime_error("Begin record of command buffer failed");
+
+	// Read back GPU timings of the previous use of this frame
+	VulkanGpuProfiler &gpuProfiler = this->copyCommandPool->getGpuProfiler();
+	gpuProfiler.beginFrame(this->currentFrame);
+	this->frameGpuScope = gpuProfiler.beginScope(commandBuffer, "frame");
+
+	return (true);
 }
 
 
-void	Window::endDraw(VulkanContext &context)
+void	Window::beginPass(void)
+{
+	this->drawCommands.clear();
+}
+
+
+void	Window::endPass(void)
+{
+	TRACE_SCOPE("record");
+
+	VkCommandBuffer commandBuffer = this->copyCommandBuffers[this->currentFrame];
+
+	// Group draws by pipeline, then by descriptor set, then by mesh
+	std::sort(this->drawCommands.begin(), this->drawCommands.end(),
+		[](const DrawCommand &a, const DrawCommand &b)
+		{
+			if (a.pipeline != b.pipeline)
+				return (a.pipeline < b.pipeline);
+			if (a.descriptorSet != b.descriptorSet)
+				return (a.descriptorSet < b.descriptorSet);
+			return (a.vertexBuffer < b.vertexBuffer);
+		});
+
+	// Take ownership of resources uploaded on transfer queue
+	this->copyCommandPool->recordPendingAcquires(commandBuffer);
+
+	size_t		nbDraws = this->drawCommands.size();
+	uint32_t	nbJobs = 1;
+
+	this->frameStats.nbDraws = static_cast<uint32_t>(nbDraws);
+	this->frameStats.nbTriangles = 0;
+	for (const DrawCommand &drawCommand : this->drawCommands)
+		this->frameStats.nbTriangles += static_cast<uint64_t>(drawCommand.nbIndex / 3) * drawCommand.nbInstance;
+
+	if (this->copyJobPool != NULL && this->copyCommandPool->getNbThreads() > 1)
+	{
+		nbJobs = static_cast<uint32_t>((nbDraws + MIN_DRAWS_PER_RECORD_JOB - 1) / MIN_DRAWS_PER_RECORD_JOB);
+		nbJobs = std::min(nbJobs, this->copyCommandPool->getNbThreads());
+	}
+
+	VulkanGpuProfiler	&gpuProfiler = this->copyCommandPool->getGpuProfiler();
+	uint32_t			passGpuScope = gpuProfiler.beginScope(commandBuffer, "pass");
+
+	// Not enough draws to pay threads synchronisation, record them inline
+	if (nbJobs <= 1)
+	{
+		this->beginRenderPass(VK_SUBPASS_CONTENTS_INLINE);
+		this->setViewportAndScissor(commandBuffer);
+		this->recordDraws(commandBuffer, 0, nbDraws);
+		vkCmdEndRenderPass(commandBuffer);
+		gpuProfiler.endScope(commandBuffer, passGpuScope);
+		return ;
+	}
+
+	// Split sorted draws in contiguous ranges, one secondary buffer per range
+	this->secondaryCommandBuffers.resize(nbJobs);
+	this->copyJobPool->run(nbJobs, [this, nbDraws, nbJobs](uint32_t jobId, uint32_t threadId)
+		{
+			size_t	start = nbDraws * jobId / nbJobs;
+			size_t	end = nbDraws * (jobId + 1) / nbJobs;
+
+			TRACE_SCOPE("record job");
+			this->secondaryCommandBuffers[jobId] = this->recordSecondaryDraws(threadId, start, end);
+		});
+
+	// Execute secondary buffers in draws order
+	this->beginRenderPass(VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+	vkCmdExecuteCommands(commandBuffer, nbJobs, this->secondaryCommandBuffers.data());
+	vkCmdEndRenderPass(commandBuffer);
+	gpuProfiler.endScope(commandBuffer, passGpuScope);
+}
+
+
+void	Window::endFrame(VulkanContext &context)
 {
 	VkQueue graphicsQueue = context.getGraphicsQueue();
 	VkQueue presentQueue = context.getPresentQueue();
 
+	this->copyCommandPool->getGpuProfiler().endScope(
+		this->copyCommandBuffers[this->currentFrame], this->frameGpuScope);
+
+	if (vkEndCommandBuffer(this->copyCommandBuffers[this->currentFrame]) != VK_SUCCESS)
+		throw std::runtime_error("Command buffer record failed");
+
+	VulkanTimeline			&graphicsTimeline = this->copyCommandPool->getGraphicsTimeline();
+	const VulkanTimeline	&transferTimeline = this->copyCommandPool->getTransferTimeline();
+
+	// Wait swap chain image, and uploads done on transfer queue
+	VkSemaphore waitSemaphores[] = {this->imageAvailableSemaphores[this->currentFrame],
+									transferTimeline.getSemaphore()};
+	VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+											VK_PIPELINE_STAGE_VERTEX_INPUT_BIT
+											| VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT};
+	uint64_t waitValues[] = {0, transferTimeline.getLastValue()};
+	uint32_t nbWaits = this->copyCommandPool->hasTransferQueue() ? 2 : 1;
+	// Offscreen images don't wait acquisition nor signal presentation
+	uint32_t firstSemaphore = this->headless ? 1 : 0;
+
+	// Signal presentation, and frame end on graphics timeline (value ignored for binary)
+	uint64_t frameValue = graphicsTimeline.nextValue();
+	VkSemaphore signalSemaphores[] = {this->renderFinishedSemaphores[this->currentFrame],
+										graphicsTimeline.getSemaphore()};
+	uint64_t signalValues[] = {0, frameValue};
+
+	VkTimelineSemaphoreSubmitInfo timelineInfo{};
+	timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+	timelineInfo.waitSemaphoreValueCount = nbWaits - firstSemaphore;
+	timelineInfo.pWaitSemaphoreValues = waitValues + firstSemaphore;
+	timelineInfo.signalSemaphoreValueCount = 2 - firstSemaphore;
+	timelineInfo.pSignalSemaphoreValues = signalValues + firstSemaphore;
+
 	VkSubmitInfo submitInfo{};
 	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-
-	VkSemaphore waitSemaphores[] = {this->imageAvailableSemaphores[this->currentFrame]};
-	VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-	submitInfo.waitSemaphoreCount = 1;
-	submitInfo.pWaitSemaphores = waitSemaphores;
-	submitInfo.pWaitDstStageMask = waitStages;
+	submitInfo.pNext = &timelineInfo;
+	submitInfo.waitSemaphoreCount = nbWaits - firstSemaphore;
+	submitInfo.pWaitSemaphores = waitSemaphores + firstSemaphore;
+	submitInfo.pWaitDstStageMask = waitStages + firstSemaphore;
 	submitInfo.commandBufferCount = 1;
 	submitInfo.pCommandBuffers = &this->copyCommandBuffers[this->currentFrame];
+	submitInfo.signalSemaphoreCount = 2 - firstSemaphore;
+	submitInfo.pSignalSemaphores = signalSemaphores + firstSemaphore;
 
-	VkSemaphore signalSemaphores[] = {this->renderFinishedSemaphores[this->currentFrame]};
-	submitInfo.signalSemaphoreCount = 1;
-	submitInfo.pSignalSemaphores = signalSemaphores;
-
-	if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, this->inFlightFences[this->currentFrame]) != VK_SUCCESS)
+	if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
 		throw std::runtime_error("Draw command buffer submit failed");
 
+	this->frameTimelineValues[this->currentFrame] = frameValue;
+	// Objects deleted until now can be used by this frame
+	this->copyCommandPool->getDeletionQueue().seal(frameValue);
+
+	// Offscreen image stay available for saveFrame
+	if (this->headless)
+	{
+		this->lastImageIndex = this->imageIndex;
+		this->currentFrame = (this->currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+		return ;
+	}
+
 	VkPresentInfoKHR presentInfo{};
 	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 	presentInfo.waitSemaphoreCount = 1;
@@ -306,7 +509,11 @@ void	Window::endDraw(VulkanContext &context)
 	presentInfo.pImageIndices = &this->imageIndex;
 	presentInfo.pResults = nullptr; // Optional
 
-	VkResult result = vkQueuePresentKHR(presentQueue, &presentInfo);
+	VkResult result;
+	{
+		TRACE_SCOPE("present");
+		result = vkQueuePresentKHR(presentQueue, &presentInfo);
+	}
 	// Check if we need to recreate swap chain (because window size change)
 	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized)
 	{
@@ -319,11 +526,110 @@ void	Window::endDraw(VulkanContext &context)
 	this->currentFrame = (this->currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 }
 
+//---- Profiling ---------------------------------------------------------------
+
+uint32_t	Window::beginGpuScope(const char *name)
+{
+	return (this->copyCommandPool->getGpuProfiler().beginScope(
+				this->copyCommandBuffers[this->currentFrame], name));
+}
+
+
+void	Window::endGpuScope(uint32_t scopeId)
+{
+	this->copyCommandPool->getGpuProfiler().endScope(
+		this->copyCommandBuffers[this->currentFrame], scopeId);
+}
+
+//---- Readback ----------------------------------------------------------------
+
+void	Window::saveFrame(const std::string &path)
+{
+	if (!this->headless)
+		throw std::runtime_error("Frame readback is only available in headless mode");
+
+	// Wait the render of last frame
+	VulkanTimeline &graphicsTimeline = this->copyCommandPool->getGraphicsTimeline();
+	graphicsTimeline.wait(graphicsTimeline.getLastValue());
+
+	uint32_t		width = this->swapChainExtent.width;
+	uint32_t		height = this->swapChainExtent.height;
+	VkDeviceSize	imageSize = (VkDeviceSize)width * height * 4;
+	VkBuffer		stagingBuffer;
+	VkDeviceMemory	stagingBufferMemory;
+
+	createVulkanBuffer(this->copyDevice, this->copyPhysicalDevice, imageSize,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+		stagingBuffer, stagingBufferMemory);
+
+	// Copy image to host visible buffer, render pass already left it in transfer layout
+	VkCommandBuffer commandBuffer = this->copyCommandPool->beginSingleTimeCommands();
+
+	// Make color attachment writes visible to transfer
+	VkMemoryBarrier barrier{};
+	barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+	vkCmdPipelineBarrier(commandBuffer,
+		VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+	VkBufferImageCopy region{};
+	region.bufferOffset = 0;
+	region.bufferRowLength = 0;
+	region.bufferImageHeight = 0;
+	region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	region.imageSubresource.mipLevel = 0;
+	region.imageSubresource.baseArrayLayer = 0;
+	region.imageSubresource.layerCount = 1;
+	region.imageOffset = {0, 0, 0};
+	region.imageExtent = {width, height, 1};
+
+	vkCmdCopyImageToBuffer(commandBuffer, this->swapChainImages[this->lastImageIndex],
+		VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, stagingBuffer, 1, &region);
+
+	this->copyCommandPool->endSingleTimeCommands(commandBuffer);
+
+	// Write pixels, as binary ppm or raw rgba
+	void			*data;
+	std::ofstream	file(path, std::ios::binary);
+	bool			ppm = path.size() >= 4 && path.compare(path.size() - 4, 4, ".ppm") == 0;
+
+	vkMapMemory(this->copyDevice, stagingBufferMemory, 0, imageSize, 0, &data);
+	if (file.is_open())
+	{
+		const unsigned char	*pixels = (const unsigned char *)data;
+
+		if (ppm)
+		{
+			file << "P6\n" << width << " " << height << "\n255\n";
+			for (VkDeviceSize i = 0; i < imageSize; i += 4)
+				file.write((const char *)pixels + i, 3);
+		}
+		else
+			file.write((const char *)pixels, imageSize);
+	}
+	vkUnmapMemory(this->copyDevice, stagingBufferMemory);
+
+	vkDestroyBuffer(this->copyDevice, stagingBuffer, nullptr);
+	vkFreeMemory(this->copyDevice, stagingBufferMemory, nullptr);
+
+	if (!file.is_open() || !file.good())
+		throw std::runtime_error("Failed to write frame to " + path);
+}
+
 //**** STATIC METHODS **********************************************************
 //**** PRIVATE METHODS *********************************************************
 
 void	Window::createSwapChain(void)
 {
+	if (this->headless)
+	{
+		this->createOffscreenImages();
+		return ;
+	}
+
 	SwapChainSupportDetails swapChainSupport = querySwapChainSupport(this->copyPhysicalDevice, this->surface);
 
 	VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
@@ -363,11 +669,19 @@ void	Window::createSwapChain(void)
 	createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
 	createInfo.presentMode = presentMode;
 	createInfo.clipped = VK_TRUE;
-	createInfo.oldSwapchain = VK_NULL_HANDLE;
+	// Let driver reuse resources of the previous swap chain
+	VkSwapchainKHR oldSwapChain = this->swapChain;
+	createInfo.oldSwapchain = oldSwapChain;
 
 	if (vkCreateSwapchainKHR(this->copyDevice, &createInfo, nullptr, &this->swapChain) != VK_SUCCESS)
 		throw std::runtime_error("Swap chain creation failed");
 
+	if (oldSwapChain != NULL)
+		this->copyCommandPool->getDeletionQueue().push([oldSwapChain](VkDevice device)
+		{
+			vkDestroySwapchainKHR(device, oldSwapChain, nullptr);
+		});
+
 	vkGetSwapchainImagesKHR(this->copyDevice, this->swapChain, &imageCount, nullptr);
 	swapChainImages.resize(imageCount);
 	vkGetSwapchainImagesKHR(this->copyDevice, this->swapChain, &imageCount, swapChainImages.data());
@@ -377,6 +691,26 @@ void	Window::createSwapChain(void)
 }
 
 
+void	Window::createOffscreenImages(void)
+{
+	this->swapChainImageFormat = VK_FORMAT_R8G8B8A8_SRGB;
+	this->swapChainExtent = {(uint32_t)this->size.x, (uint32_t)this->size.y};
+
+	// One image per frame in flight, like a swap chain without presentation
+	this->swapChainImages.assign(MAX_FRAMES_IN_FLIGHT, NULL);
+	this->offscreenImageMemories.assign(MAX_FRAMES_IN_FLIGHT, NULL);
+	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+		createVulkanImage(
+			this->copyDevice, this->copyPhysicalDevice,
+			this->swapChainExtent.width, this->swapChainExtent.height,
+			this->swapChainImageFormat, VK_IMAGE_TILING_OPTIMAL,
+			VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			this->swapChainImages[i], this->offscreenImageMemories[i]);
+	this->lastImageIndex = 0;
+}
+
+
 void	Window::createImageViews(void)
 {
 	this->swapChainImageViews.resize(swapChainImages.size());
@@ -393,21 +727,17 @@ void	Window::createSyncObjects(void)
 {
 	imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
 	renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-	inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+	// Frames are synchronised with graphics timeline, 0 mean never submitted
+	frameTimelineValues.assign(MAX_FRAMES_IN_FLIGHT, 0);
 
 	VkSemaphoreCreateInfo semaphoreInfo{};
 	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-	VkFenceCreateInfo fenceInfo{};
-	fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-	fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
 	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
 	{
 		if (vkCreateSemaphore(this->copyDevice, &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
-			vkCreateSemaphore(this->copyDevice, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS ||
-			vkCreateFence(this->copyDevice, &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS)
-			throw std::runtime_error("Semaphore or fence creation failed");
+			vkCreateSemaphore(this->copyDevice, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS)
+			throw std::runtime_error("Semaphore creation failed");
 	}
 }
 
@@ -423,7 +753,11 @@ void	Window::createRenderPass(void)
 	colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 	colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 	colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	// Offscreen images are copied to host instead of presented
+	if (this->headless)
+		colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	else
+		colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
 	// Define subpasses (can be used for post processing)
 	VkAttachmentReference colorAttachmentRef{};
@@ -547,18 +881,235 @@ void	Window::destroySwapChain(void)
 	// Swap chain
 	if (this->swapChain != NULL)
 		vkDestroySwapchainKHR(this->copyDevice, this->swapChain, nullptr);
+
+	// Offscreen images, owned by window instead of swap chain
+	if (this->headless)
+	{
+		for (VkImage image : this->swapChainImages)
+			vkDestroyImage(this->copyDevice, image, nullptr);
+		for (VkDeviceMemory memory : this->offscreenImageMemories)
+			vkFreeMemory(this->copyDevice, memory, nullptr);
+		this->swapChainImages.clear();
+		this->offscreenImageMemories.clear();
+	}
+}
+
+
+void	Window::retireSwapChain(void)
+{
+	if (this->copyDevice == NULL)
+		return ;
+
+	VkImageView					depthImageView = this->depthImageView;
+	VkImage						depthImage = this->depthImage;
+	VkDeviceMemory				depthImageMemory = this->depthImageMemory;
+	std::vector<VkFramebuffer>	framebuffers = std::move(this->swapChainFramebuffers);
+	std::vector<VkImageView>	imageViews = std::move(this->swapChainImageViews);
+	// Swap chain images are owned by swap chain, only offscreen ones are freed
+	std::vector<VkImage>		offscreenImages;
+	std::vector<VkDeviceMemory>	offscreenImageMemories = std::move(this->offscreenImageMemories);
+	if (this->headless)
+		offscreenImages = std::move(this->swapChainImages);
+
+	this->copyCommandPool->getDeletionQueue().push(
+		[depthImageView, depthImage, depthImageMemory, framebuffers, imageViews,
+			offscreenImages, offscreenImageMemories](VkDevice device)
+	{
+		// Depth resources
+		if (depthImageView != NULL)
+			vkDestroyImageView(device, depthImageView, nullptr);
+		if (depthImage != NULL)
+			vkDestroyImage(device, depthImage, nullptr);
+		if (depthImageMemory != NULL)
+			vkFreeMemory(device, depthImageMemory, nullptr);
+
+		// Frame buffers
+		for (VkFramebuffer framebuffer : framebuffers)
+			vkDestroyFramebuffer(device, framebuffer, nullptr);
+
+		// Image view
+		for (VkImageView imageView : imageViews)
+			vkDestroyImageView(device, imageView, nullptr);
+
+		// Offscreen images
+		for (VkImage image : offscreenImages)
+			vkDestroyImage(device, image, nullptr);
+		for (VkDeviceMemory memory : offscreenImageMemories)
+			vkFreeMemory(device, memory, nullptr);
+	});
+
+	this->depthImageView = NULL;
+	this->depthImage = NULL;
+	this->depthImageMemory = NULL;
+	this->swapChainFramebuffers.clear();
+	this->swapChainImageViews.clear();
+	// Swap chain handle is kept to be given as old swap chain at creation
+}
+
+
+void	Window::getShaderInfo(DrawCommand &drawCommand, Shader &shader, const void *pushConstants, uint32_t variant)
+{
+	drawCommand.pipeline = shader.getGraphicsPipeline(variant);
+	drawCommand.pipelineLayout = shader.getPipelineLayout();
+	drawCommand.descriptorSet = shader.getDescriptorSet(*this);
+	drawCommand.nbDynamicOffsets = shader.getDynamicOffsets(*this, drawCommand.dynamicOffsets);
+
+	// Without values, nothing is pushed for this draw
+	drawCommand.pushConstantRanges = shader.getPushConstantRanges().data();
+	drawCommand.nbPushConstantRanges = 0;
+	if (pushConstants != nullptr)
+	{
+		drawCommand.nbPushConstantRanges = shader.getPushConstantRanges().size();
+		memcpy(drawCommand.pushConstants, pushConstants, shader.getPushConstantsSize());
+	}
 }
 
 
-void	Window::getShaderInfo(
-				VkPipelineLayout &pipelineLayout,
-				VkPipeline &graphicsPipeline,
-				std::vector<VkDescriptorSet> &descriptorSets,
-				Shader &shader)
+void	Window::beginRenderPass(VkSubpassContents contents)
 {
-	pipelineLayout = shader.getPipelineLayout();
-	graphicsPipeline = shader.getGraphicsPipeline();
-	descriptorSets = shader.getDescriptorSets();
+	VkCommandBuffer commandBuffer = this->copyCommandBuffers[this->currentFrame];
+
+	// Define render process
+	VkRenderPassBeginInfo renderPassInfo{};
+	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+	renderPassInfo.renderPass = this->renderPass;
+	renderPassInfo.framebuffer = this->swapChainFramebuffers[this->imageIndex];
+	renderPassInfo.renderArea.offset = {0, 0};
+	renderPassInfo.renderArea.extent = this->swapChainExtent;
+
+	// Depth clear
+	std::array<VkClearValue, 2> clearValues{};
+	clearValues[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
+	clearValues[1].depthStencil = {1.0f, 0};
+
+	renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
+	renderPassInfo.pClearValues = clearValues.data();
+
+	// Start render process
+	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, contents);
+}
+
+
+void	Window::setViewportAndScissor(VkCommandBuffer commandBuffer)
+{
+	// Define draw region size
+	VkViewport viewport{};
+	viewport.x = 0.0f;
+	viewport.y = 0.0f;
+	viewport.width = static_cast<float>(this->swapChainExtent.width);
+	viewport.height = static_cast<float>(this->swapChainExtent.height);
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+	// Define draw region mask
+	VkRect2D scissor{};
+	scissor.offset = {0, 0};
+	scissor.extent = this->swapChainExtent;
+	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+}
+
+
+void	Window::recordDraws(VkCommandBuffer commandBuffer, size_t start, size_t end)
+{
+	// Record draws, binding only what change from previous draw
+	VkPipeline		boundPipeline = VK_NULL_HANDLE;
+	VkDescriptorSet	boundDescriptorSet = VK_NULL_HANDLE;
+	const uint32_t	*boundDynamicOffsets = nullptr;
+	VkBuffer		boundVertexBuffer = VK_NULL_HANDLE;
+	VkBuffer		boundInstanceBuffer = VK_NULL_HANDLE;
+	VkBuffer		boundIndexBuffer = VK_NULL_HANDLE;
+	VkDeviceSize	offsets[] = {0};
+
+	for (size_t i = start; i < end; i++)
+	{
+		const DrawCommand &drawCommand = this->drawCommands[i];
+
+		if (drawCommand.pipeline != boundPipeline)
+		{
+			vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, drawCommand.pipeline);
+			boundPipeline = drawCommand.pipeline;
+			// A new pipeline can have an other layout, so rebind set
+			boundDescriptorSet = VK_NULL_HANDLE;
+		}
+
+		// Same set is shared by all draws of a shader, only ubo offsets change
+		if (drawCommand.descriptorSet != boundDescriptorSet
+			|| memcmp(drawCommand.dynamicOffsets, boundDynamicOffsets,
+						drawCommand.nbDynamicOffsets * sizeof(uint32_t)) != 0)
+		{
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+									drawCommand.pipelineLayout, 0, 1,
+									&drawCommand.descriptorSet,
+									drawCommand.nbDynamicOffsets, drawCommand.dynamicOffsets);
+			boundDescriptorSet = drawCommand.descriptorSet;
+			boundDynamicOffsets = drawCommand.dynamicOffsets;
+		}
+
+		// Each range is pushed with its own stage, as Vulkan require
+		for (uint32_t j = 0; j < drawCommand.nbPushConstantRanges; j++)
+		{
+			const VkPushConstantRange &range = drawCommand.pushConstantRanges[j];
+
+			vkCmdPushConstants(commandBuffer, drawCommand.pipelineLayout,
+								range.stageFlags, range.offset, range.size,
+								drawCommand.pushConstants + range.offset);
+		}
+
+		if (drawCommand.vertexBuffer != boundVertexBuffer)
+		{
+			vkCmdBindVertexBuffers(commandBuffer, 0, 1, &drawCommand.vertexBuffer, offsets);
+			boundVertexBuffer = drawCommand.vertexBuffer;
+		}
+
+		// Instance data is at binding 1, only read by instanced pipelines
+		if (drawCommand.instanceBuffer != VK_NULL_HANDLE
+			&& drawCommand.instanceBuffer != boundInstanceBuffer)
+		{
+			vkCmdBindVertexBuffers(commandBuffer, 1, 1, &drawCommand.instanceBuffer, offsets);
+			boundInstanceBuffer = drawCommand.instanceBuffer;
+		}
+
+		if (drawCommand.indexBuffer != boundIndexBuffer)
+		{
+			vkCmdBindIndexBuffer(commandBuffer, drawCommand.indexBuffer, 0, drawCommand.indexType);
+			boundIndexBuffer = drawCommand.indexBuffer;
+		}
+
+		vkCmdDrawIndexed(commandBuffer, drawCommand.nbIndex, drawCommand.nbInstance, 0, 0, 0);
+	}
+}
+
+
+VkCommandBuffer	Window::recordSecondaryDraws(uint32_t threadId, size_t start, size_t end)
+{
+	VkCommandBuffer commandBuffer = this->copyCommandPool->allocateSecondaryCommandBuffer(
+														threadId, this->currentFrame);
+
+	// Secondary buffer continue the render pass of frame command buffer
+	VkCommandBufferInheritanceInfo inheritanceInfo{};
+	inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+	inheritanceInfo.renderPass = this->renderPass;
+	inheritanceInfo.subpass = 0;
+	inheritanceInfo.framebuffer = this->swapChainFramebuffers[this->imageIndex];
+
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+						| VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+	beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+	if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+		throw std::runtime_error("Begin record of secondary command buffer failed");
+
+	// Dynamic states aren't inherited from primary buffer
+	this->setViewportAndScissor(commandBuffer);
+	this->recordDraws(commandBuffer, start, end);
+
+	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+		throw std::runtime_error("Secondary command buffer record failed");
+
+	return (commandBuffer);
 }
 
 //**** FUNCTIONS ***************************************************************
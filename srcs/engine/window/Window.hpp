@@ -4,14 +4,48 @@
 # include <define.hpp>
 # include <engine/vulkan/VulkanUtils.hpp>
 # include <engine/vulkan/VulkanCommandPool.hpp>
+# include <engine/vulkan/VulkanFrameAllocator.hpp>
 # include <engine/mesh/Mesh.hpp>
+# include <engine/mesh/InstanceBuffer.hpp>
+# include <engine/jobs/JobPool.hpp>
 
 # include <gmath.hpp>
 # include <string>
+# include <vector>
 
 class Shader;
 class VulkanContext;
 
+/**
+ * @brief Struct for a draw queued between beginPass and endPass.
+ */
+struct DrawCommand
+{
+	VkPipeline			pipeline;
+	VkPipelineLayout	pipelineLayout;
+	VkDescriptorSet		descriptorSet;
+	uint32_t			nbDynamicOffsets;
+	uint32_t			dynamicOffsets[SHADER_MAX_UBO];
+	const VkPushConstantRange	*pushConstantRanges;
+	uint32_t			nbPushConstantRanges;
+	char				pushConstants[SHADER_MAX_PUSH_CONSTANTS_SIZE];
+	VkBuffer			vertexBuffer;
+	VkBuffer			indexBuffer;
+	VkIndexType			indexType;
+	uint32_t			nbIndex;
+	VkBuffer			instanceBuffer;
+	uint32_t			nbInstance;
+};
+
+/**
+ * @brief Struct for statistics of the last recorded pass.
+ */
+struct FrameStats
+{
+	uint32_t	nbDraws;
+	uint64_t	nbTriangles;
+};
+
 /**
  * @brief Class for window and attach process of it.
  */
@@ -27,6 +61,15 @@ public:
 	 * @return The default Window.
 	 */
 	Window(void);
+	/**
+	 * @brief Contructor of Window class.
+	 *
+	 * @param headless If true, no glfw window nor surface are created and
+	 * frames are rendered into offscreen images.
+	 *
+	 * @return The Window.
+	 */
+	Window(bool headless);
 	/**
 	 * @brief Copy constructor of Window class.
 	 *
@@ -56,6 +99,12 @@ public:
 	 * @return Vulkan surface.
 	 */
 	VkSurfaceKHR	getSurface(void) const;
+	/**
+	 * @brief Getter of headless mode.
+	 *
+	 * @return True if frames are rendered offscreen.
+	 */
+	bool	isHeadless(void) const;
 	/**
 	 * @brief Getter of vulkan render pass.
 	 *
@@ -68,6 +117,12 @@ public:
 	 * @return Current frame index as uint32.
 	 */
 	uint32_t	getCurrentFrame(void);
+	/**
+	 * @brief Getter of frame allocator, for transient allocations of current frame.
+	 *
+	 * @return Reference to frame allocator.
+	 */
+	VulkanFrameAllocator	&getFrameAllocator(void);
 	/**
 	 * @brief Getter of window size.
 	 *
@@ -80,6 +135,12 @@ public:
 	 * @return Window title as string.
 	 */
 	const std::string	&getTitle(void) const;
+	/**
+	 * @brief Getter of statistics of the last recorded pass.
+	 *
+	 * @return Frame statistics.
+	 */
+	const FrameStats	&getFrameStats(void) const;
 
 //---- Setters -----------------------------------------------------------------
 	/**
@@ -94,6 +155,13 @@ public:
 	 * @param title New title of window.
 	 */
 	void	setTitle(const std::string &title);
+	/**
+	 * @brief Setter of job pool used for record draws in parallel.
+	 *
+	 * @param jobPool The job pool. Command pool must have thread pools for
+	 * each thread of it.
+	 */
+	void	setJobPool(JobPool &jobPool);
 
 //---- Operators ---------------------------------------------------------------
 	/**
@@ -122,7 +190,8 @@ public:
 	 */
 	void	init(VulkanCommandPool &commandPool);
 	/**
-	 * @brief Recreate the swap chain. Work only if you already have call init.
+	 * @brief Recreate the swap chain without waiting the GPU, old resources
+	 * go to deletion queue. Work only if you already have call init.
 	 */
 	void	recreateSwapChain(void);
 //---- Destroy -----------------------------------------------------------------
@@ -134,95 +203,135 @@ public:
 	void	destroy(VkInstance instance);
 //---- Draw --------------------------------------------------------------------
 	/**
-	 * @brief Prepare drawing.
+	 * @brief Start a frame. Wait the frame slot, acquire a swap chain image and
+	 * begin the record of the frame command buffer.
+	 *
+	 * @return False if the frame is skipped (swap chain recreated), true else.
 	 *
 	 * @warning Will crash if you don't have call init method before. (No check for speed).
+	 * @exception Throw an runtime_error if the record can't start.
 	 */
-	void	startDraw(void);
+	bool	beginFrame(void);
 	/**
-	 * @brief Draw a mesh with a render pipeline.
+	 * @brief Start a render pass. Draws are queued until endPass.
+	 */
+	void	beginPass(void);
+	/**
+	 * @brief Queue a mesh draw with a render pipeline. Nothing is recorded
+	 * before endPass, so it can be called many times per frame.
 	 *
 	 * @param mesh Mesh to draw.
 	 * @param shader Shader used to draw mesh.
 	 */
 	template<typename VertexType>
-	void	drawMesh(Mesh<VertexType> &mesh, Shader &shader)
+	void	draw(Mesh<VertexType> &mesh, Shader &shader)
 	{
-		VkCommandBuffer commandBuffer = this->copyCommandBuffers[this->currentFrame];
-		VkPipelineLayout pipelineLayout;
-		VkPipeline graphicsPipeline;
-		std::vector<VkDescriptorSet> descriptorSets;
-
-		getShaderInfo(pipelineLayout,graphicsPipeline, descriptorSets, shader);
-
-		VkCommandBufferBeginInfo beginInfo{};
-		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		beginInfo.flags = 0; // Optional
-		beginInfo.pInheritanceInfo = nullptr; // Optional
-
-		if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
-			throw std::runtime_error("Begin record of command buffer failed");
-
-		// Define render process
-		VkRenderPassBeginInfo renderPassInfo{};
-		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		renderPassInfo.renderPass = this->renderPass;
-		renderPassInfo.framebuffer = this->swapChainFramebuffers[this->imageIndex];
-		renderPassInfo.renderArea.offset = {0, 0};
-		renderPassInfo.renderArea.extent = this->swapChainExtent;
-
-		// Depth clear
-		std::array<VkClearValue, 2> clearValues{};
-		clearValues[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
-		clearValues[1].depthStencil = {1.0f, 0};
-
-		renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-		renderPassInfo.pClearValues = clearValues.data();
-
-		// Start render process
-		vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
-
-		// Define draw region size
-		VkViewport viewport{};
-		viewport.x = 0.0f;
-		viewport.y = 0.0f;
-		viewport.width = static_cast<float>(this->swapChainExtent.width);
-		viewport.height = static_cast<float>(this->swapChainExtent.height);
-		viewport.minDepth = 0.0f;
-		viewport.maxDepth = 1.0f;
-		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+		this->draw(mesh, shader, nullptr);
+	}
+	/**
+	 * @brief Queue a mesh draw with a render pipeline and per draw values
+	 * given by push constants. Nothing is recorded before endPass, so it can
+	 * be called many times per frame.
+	 *
+	 * @param mesh Mesh to draw.
+	 * @param shader Shader used to draw mesh.
+	 * @param pushConstants Pointer of push constant values, packed like push
+	 * constant types of shader. Values are copied. Can be nullptr if shader
+	 * don't use push constants.
+	 * @param variant Id of shader pipeline variant, 0 is the base pipeline.
+	 */
+	template<typename VertexType>
+	void	draw(Mesh<VertexType> &mesh, Shader &shader, const void *pushConstants, uint32_t variant = 0)
+	{
+		DrawCommand	drawCommand;
 
-		// Define draw region mask
-		VkRect2D scissor{};
-		scissor.offset = {0, 0};
-		scissor.extent = this->swapChainExtent;
-		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+		this->getShaderInfo(drawCommand, shader, pushConstants, variant);
+		drawCommand.vertexBuffer = mesh.getVertexBuffer();
+		drawCommand.indexBuffer = mesh.getIndexBuffer();
+		drawCommand.indexType = mesh.getIndexType();
+		drawCommand.nbIndex = mesh.getNbIndex();
+		drawCommand.instanceBuffer = VK_NULL_HANDLE;
+		drawCommand.nbInstance = 1;
 
-		// Use vertex and index buffers
-		VkBuffer vertexBuffers[] = {mesh.getVertexBuffer()};
-		VkDeviceSize offsets[] = {0};
-		vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
-		vkCmdBindIndexBuffer(commandBuffer, mesh.getIndexBuffer(), 0, VK_INDEX_TYPE_UINT32);
+		this->drawCommands.push_back(drawCommand);
+	}
+	/**
+	 * @brief Queue one draw of a mesh for each instance of an instance
+	 * buffer. Shader must be init with the same instance type. Nothing is
+	 * recorded before endPass.
+	 *
+	 * @param mesh Mesh to draw.
+	 * @param instances Per instance data, with its buffer created.
+	 * @param shader Shader used to draw mesh, init with InstanceType.
+	 * @param pushConstants Pointer of push constant values shared by all
+	 * instances, packed like push constant types of shader. Values are
+	 * copied. Can be nullptr if shader don't use push constants.
+	 * @param variant Id of shader pipeline variant, 0 is the base pipeline.
+	 */
+	template<typename VertexType, typename InstanceType>
+	void	drawInstanced(
+				Mesh<VertexType> &mesh, InstanceBuffer<InstanceType> &instances,
+				Shader &shader, const void *pushConstants = nullptr, uint32_t variant = 0)
+	{
+		if (instances.getNbInstance() == 0)
+			return ;
 
-		// Bind uniform
-		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[currentFrame], 0, nullptr);
+		DrawCommand	drawCommand;
 
-		// Draw with index
-		vkCmdDrawIndexed(commandBuffer, mesh.getNbIndex(), 1, 0, 0, 0);
+		this->getShaderInfo(drawCommand, shader, pushConstants, variant);
+		drawCommand.vertexBuffer = mesh.getVertexBuffer();
+		drawCommand.indexBuffer = mesh.getIndexBuffer();
+		drawCommand.indexType = mesh.getIndexType();
+		drawCommand.nbIndex = mesh.getNbIndex();
+		drawCommand.instanceBuffer = instances.getBuffer();
+		drawCommand.nbInstance = instances.getNbInstance();
 
-		// Wait drawing end
-		vkCmdEndRenderPass(commandBuffer);
-		if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
-			throw std::runtime_error("Command buffur record failed");
+		this->drawCommands.push_back(drawCommand);
 	}
+	/**
+	 * @brief Record queued draws, sorted by pipeline and descriptor set to
+	 * minimise state changes, then end the render pass.
+	 * If there are enough draws and a job pool is set, draws are split between
+	 * threads, each one recording a secondary command buffer.
+	 */
+	void	endPass(void);
 	/**
 	 * @brief Finish and apply draw onto window.
 	 *
-	 * @param graphicsQueue Vulkan contexte graphics queue.
-	 * @param presentQueue Vulkan contexte present queue.
+	 * @param context Vulkan context, used for graphics and present queues.
+	 *
+	 * @exception Throw an runtime_error if the submit or the presentation failed.
+	 */
+	void	endFrame(VulkanContext &context);
+//---- Profiling ---------------------------------------------------------------
+	/**
+	 * @brief Start a named GPU scope into the frame command buffer. Draws are
+	 * recorded by endPass, so a scope around draw calls time nothing, use it
+	 * around whole passes or other recorded commands.
+	 *
+	 * @param name Name of the scope, must outlive the read back (string literal).
+	 *
+	 * @return Id of the scope, for endGpuScope.
+	 */
+	uint32_t	beginGpuScope(const char *name);
+	/**
+	 * @brief End a named GPU scope. Times are available from GPU profiler of
+	 * command pool, some frames later.
+	 *
+	 * @param scopeId Id given by beginGpuScope.
 	 */
-	void	endDraw(VulkanContext &context);
+	void	endGpuScope(uint32_t scopeId);
+//---- Readback ----------------------------------------------------------------
+	/**
+	 * @brief Copy the last rendered frame to a file. Wait the end of its render.
+	 * Path ending with .ppm give a binary ppm, else raw rgba8 pixels.
+	 *
+	 * @param path Path of the file to write.
+	 *
+	 * @exception Throw an runtime_error if window is not headless or if the
+	 * file can't be written.
+	 */
+	void	saveFrame(const std::string &path);
 
 //**** STATIC METHODS **********************************************************
 
@@ -233,27 +342,37 @@ private:
 	gm::Vec2i						size;
 	std::string						title;
 	VkSurfaceKHR					surface;
+	bool							headless;
 //---- Swap chain --------------------------------------------------------------
 	uint32_t						imageIndex;
 	uint32_t						currentFrame;
 	VkSwapchainKHR					swapChain;
 	std::vector<VkImage>			swapChainImages;
+	std::vector<VkDeviceMemory>		offscreenImageMemories;
+	uint32_t						lastImageIndex;
 	VkFormat						swapChainImageFormat;
 	VkExtent2D						swapChainExtent;
 	std::vector<VkImageView>		swapChainImageViews;
 	std::vector<VkSemaphore>		imageAvailableSemaphores;
 	std::vector<VkSemaphore>		renderFinishedSemaphores;
-	std::vector<VkFence>			inFlightFences;
+	std::vector<uint64_t>			frameTimelineValues;
 	VkRenderPass					renderPass;
 	VkImage							depthImage;
 	VkDeviceMemory					depthImageMemory;
 	VkImageView						depthImageView;
 	std::vector<VkFramebuffer>		swapChainFramebuffers;
+	VulkanFrameAllocator			frameAllocator;
 //---- Copy --------------------------------------------------------------------
 	VkDevice						copyDevice;
 	VkPhysicalDevice				copyPhysicalDevice;
 	VulkanCommandPool				*copyCommandPool;
 	VkCommandBuffer					*copyCommandBuffers;
+	JobPool							*copyJobPool;
+//---- Draw --------------------------------------------------------------------
+	std::vector<DrawCommand>		drawCommands;
+	std::vector<VkCommandBuffer>	secondaryCommandBuffers;
+	FrameStats						frameStats;
+	uint32_t						frameGpuScope;
 
 //**** PRIVATE METHODS *********************************************************
 //---- Creation ----------------------------------------------------------------
@@ -261,6 +380,10 @@ private:
 	 * @brief Create swap chain images, image format and extend.
 	 */
 	void	createSwapChain(void);
+	/**
+	 * @brief Create offscreen images used instead of swap chain in headless mode.
+	 */
+	void	createOffscreenImages(void);
 	/**
 	 * @brief Create swap chain image views.
 	 */
@@ -287,12 +410,58 @@ private:
 	 * @brief Destroy vulkan swap chain.
 	 */
 	void	destroySwapChain(void);
+	/**
+	 * @brief Give swap chain resources to deletion queue, so they are
+	 * destroyed once frames in flight are done. Swap chain handle is kept to be
+	 * recycled by createSwapChain.
+	 */
+	void	retireSwapChain(void);
 
-	void	getShaderInfo(
-				VkPipelineLayout &pipelineLayout,
-				VkPipeline &graphicsPipeline,
-				std::vector<VkDescriptorSet> &descriptorSets,
-				Shader &shader);
+//---- Draw --------------------------------------------------------------------
+	/**
+	 * @brief Fill pipeline, pipeline layout, descriptor set of current frame
+	 * and push constants of a draw command from a shader.
+	 * Ubo offsets are captured now, so shader ubo can be updated between draws.
+	 *
+	 * @param drawCommand The draw command to fill.
+	 * @param shader Shader used for the draw.
+	 * @param pushConstants Push constant values of the draw, can be nullptr.
+	 * @param variant Id of shader pipeline variant.
+	 */
+	void	getShaderInfo(DrawCommand &drawCommand, Shader &shader, const void *pushConstants, uint32_t variant);
+	/**
+	 * @brief Begin the render pass of current frame into the frame command buffer.
+	 *
+	 * @param contents Inline if draws are recorded into the frame command buffer,
+	 * secondary command buffers else.
+	 */
+	void	beginRenderPass(VkSubpassContents contents);
+	/**
+	 * @brief Set viewport and scissor to swap chain size.
+	 *
+	 * @param commandBuffer The command buffer where record.
+	 */
+	void	setViewportAndScissor(VkCommandBuffer commandBuffer);
+	/**
+	 * @brief Record a range of the sorted draw commands.
+	 *
+	 * @param commandBuffer The command buffer where record.
+	 * @param start Index of the first draw command.
+	 * @param end Index after the last draw command.
+	 */
+	void	recordDraws(VkCommandBuffer commandBuffer, size_t start, size_t end);
+	/**
+	 * @brief Record a range of the sorted draw commands into a secondary
+	 * command buffer. Called from a job.
+	 *
+	 * @param threadId Id of the thread running the job.
+	 * @param start Index of the first draw command.
+	 * @param end Index after the last draw command.
+	 *
+	 * @return The recorded secondary command buffer.
+	 * @exception Throw an runtime_error if the record failed.
+	 */
+	VkCommandBuffer	recordSecondaryDraws(uint32_t threadId, size_t start, size_t end);
 };
 
 //**** FUNCTIONS ***************************************************************
@@ -0,0 +1,168 @@
+#include <program/benchmark/Benchmark.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <unistd.h>
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+
+Benchmark::Benchmark(void)
+{
+}
+
+//---- Destructor --------------------------------------------------------------
+
+Benchmark::~Benchmark()
+{
+}
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+
+const std::vector<FrameSample>	&Benchmark::getSamples(void) const
+{
+	return (this->samples);
+}
+
+//---- Setters -----------------------------------------------------------------
+
+void	Benchmark::setGpuTimes(size_t frame, double gpuTime, double uploadTime)
+{
+	if (frame >= this->samples.size())
+		throw std::runtime_error("Benchmark frame " + std::to_string(frame) + " has no sample");
+
+	this->samples[frame].gpuTime = gpuTime;
+	this->samples[frame].uploadTime = uploadTime;
+}
+
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+
+void	Benchmark::addSample(const FrameSample &sample)
+{
+	this->samples.push_back(sample);
+}
+
+
+void	Benchmark::write(const std::string &path) const
+{
+	std::ofstream	file(path);
+
+	if (!file.is_open())
+		throw std::runtime_error("Can't open benchmark output " + path);
+
+	if (path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0)
+		this->writeJson(file);
+	else
+		this->writeCsv(file);
+
+	if (!file.good())
+		throw std::runtime_error("Failed to write benchmark output " + path);
+}
+
+
+void	Benchmark::printSummary(std::ostream &os) const
+{
+	os << "Benchmark : " << this->samples.size() << " frames"
+		<< " | cpu p50 " << this->getPercentile(&FrameSample::cpuTime, 50.0) << " ms"
+		<< " p95 " << this->getPercentile(&FrameSample::cpuTime, 95.0) << " ms"
+		<< " p99 " << this->getPercentile(&FrameSample::cpuTime, 99.0) << " ms"
+		<< " | gpu p50 " << this->getPercentile(&FrameSample::gpuTime, 50.0) << " ms"
+		<< " p95 " << this->getPercentile(&FrameSample::gpuTime, 95.0) << " ms"
+		<< " p99 " << this->getPercentile(&FrameSample::gpuTime, 99.0) << " ms" << std::endl;
+}
+
+//**** STATIC METHODS **********************************************************
+
+uint64_t	Benchmark::getProcessMemory(void)
+{
+	std::ifstream	file("/proc/self/statm");
+	uint64_t		nbPages;
+	uint64_t		nbResidentPages;
+
+	if (!(file >> nbPages >> nbResidentPages))
+		return (0);
+
+	return (nbResidentPages * sysconf(_SC_PAGESIZE));
+}
+
+//**** PRIVATE METHODS *********************************************************
+
+double	Benchmark::getPercentile(double FrameSample::*time, double percent) const
+{
+	if (this->samples.empty())
+		return (0.0);
+
+	std::vector<double>	times;
+	times.reserve(this->samples.size());
+	for (const FrameSample &sample : this->samples)
+		times.push_back(sample.*time);
+
+	size_t	rank = (size_t)std::ceil(percent / 100.0 * times.size());
+	size_t	index = std::min(rank > 0 ? rank - 1 : 0, times.size() - 1);
+
+	std::nth_element(times.begin(), times.begin() + index, times.end());
+	return (times[index]);
+}
+
+
+void	Benchmark::writeJsonPercentiles(std::ostream &os, double FrameSample::*time) const
+{
+	os << "{\"p50\": " << this->getPercentile(time, 50.0)
+		<< ", \"p95\": " << this->getPercentile(time, 95.0)
+		<< ", \"p99\": " << this->getPercentile(time, 99.0) << "}";
+}
+
+
+void	Benchmark::writeCsv(std::ostream &os) const
+{
+	os << "# cpu_ms p50 " << this->getPercentile(&FrameSample::cpuTime, 50.0)
+		<< " p95 " << this->getPercentile(&FrameSample::cpuTime, 95.0)
+		<< " p99 " << this->getPercentile(&FrameSample::cpuTime, 99.0) << "\n";
+	os << "# gpu_ms p50 " << this->getPercentile(&FrameSample::gpuTime, 50.0)
+		<< " p95 " << this->getPercentile(&FrameSample::gpuTime, 95.0)
+		<< " p99 " << this->getPercentile(&FrameSample::gpuTime, 99.0) << "\n";
+	os << "frame,cpu_ms,gpu_ms,upload_ms,draws,triangles,memory_bytes\n";
+
+	for (size_t i = 0; i < this->samples.size(); i++)
+	{
+		const FrameSample	&sample = this->samples[i];
+
+		os << i << ',' << sample.cpuTime << ',' << sample.gpuTime << ','
+			<< sample.uploadTime << ',' << sample.nbDraws << ','
+			<< sample.nbTriangles << ',' << sample.memory << '\n';
+	}
+}
+
+
+void	Benchmark::writeJson(std::ostream &os) const
+{
+	os << "{\n";
+	os << "\t\"summary\": {\"cpu_ms\": ";
+	this->writeJsonPercentiles(os, &FrameSample::cpuTime);
+	os << ", \"gpu_ms\": ";
+	this->writeJsonPercentiles(os, &FrameSample::gpuTime);
+	os << "},\n";
+	os << "\t\"frames\": [";
+
+	for (size_t i = 0; i < this->samples.size(); i++)
+	{
+		const FrameSample	&sample = this->samples[i];
+
+		os << (i == 0 ? "\n" : ",\n")
+			<< "\t\t{\"cpu_ms\": " << sample.cpuTime
+			<< ", \"gpu_ms\": " << sample.gpuTime
+			<< ", \"upload_ms\": " << sample.uploadTime
+			<< ", \"draws\": " << sample.nbDraws
+			<< ", \"triangles\": " << sample.nbTriangles
+			<< ", \"memory_bytes\": " << sample.memory << "}";
+	}
+
+	os << "\n\t]\n}\n";
+}
+
+//**** FUNCTIONS ***************************************************************
@@ -0,0 +1,137 @@
+#ifndef BENCHMARK_HPP
+# define BENCHMARK_HPP
+
+# include <defineCore.hpp>
+
+# include <ostream>
+# include <string>
+# include <vector>
+
+/**
+ * @brief Struct for measures of one benchmarked frame.
+ */
+struct FrameSample
+{
+	double		cpuTime;
+	double		gpuTime;
+	double		uploadTime;
+	uint32_t	nbDraws;
+	uint64_t	nbTriangles;
+	uint64_t	memory;
+};
+
+/**
+ * @brief Class that collect frame samples, then write them with a
+ * percentiles summary.
+ */
+class Benchmark
+{
+public:
+//**** PUBLIC ATTRIBUTS ********************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Default contructor of Benchmark class.
+	 *
+	 * @return The default Benchmark, without samples.
+	 */
+	Benchmark(void);
+
+//---- Destructor --------------------------------------------------------------
+	/**
+	 * @brief Destructor of Benchmark class.
+	 */
+	~Benchmark();
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+	/**
+	 * @brief Getter of samples.
+	 *
+	 * @return Samples in frame order.
+	 */
+	const std::vector<FrameSample>	&getSamples(void) const;
+
+//---- Setters -----------------------------------------------------------------
+	/**
+	 * @brief Setter of GPU times of a frame, read back after its sample is
+	 * added.
+	 *
+	 * @param frame Index of the sample.
+	 * @param gpuTime GPU time of the frame, in millisecond.
+	 * @param uploadTime GPU time of uploads of the frame, in millisecond.
+	 *
+	 * @exception Throw a runtime_error if sample doesn't exist.
+	 */
+	void	setGpuTimes(size_t frame, double gpuTime, double uploadTime);
+
+//---- Operators ---------------------------------------------------------------
+//**** PUBLIC METHODS **********************************************************
+	/**
+	 * @brief Add the sample of a frame.
+	 *
+	 * @param sample Measures of the frame.
+	 */
+	void	addSample(const FrameSample &sample);
+	/**
+	 * @brief Write samples and summary. Path ending with .json give json,
+	 * else csv with summary as comment lines.
+	 *
+	 * @param path Path of the file to write.
+	 *
+	 * @exception Throw an runtime_error if the file can't be written.
+	 */
+	void	write(const std::string &path) const;
+	/**
+	 * @brief Print the cpu and gpu time percentiles summary.
+	 *
+	 * @param os Stream where print.
+	 */
+	void	printSummary(std::ostream &os) const;
+
+//**** STATIC METHODS **********************************************************
+	/**
+	 * @brief Get memory used by the process.
+	 *
+	 * @return Resident memory in bytes, 0 if unknown.
+	 */
+	static uint64_t	getProcessMemory(void);
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+	std::vector<FrameSample>	samples;
+
+//**** PRIVATE METHODS *********************************************************
+	/**
+	 * @brief Compute a percentile of a time of samples, by nearest rank.
+	 *
+	 * @param time The sample time member to use.
+	 * @param percent Wanted percentile, between 0 and 100.
+	 *
+	 * @return Time in millisecond, 0 without samples.
+	 */
+	double	getPercentile(double FrameSample::*time, double percent) const;
+	/**
+	 * @brief Write p50, p95 and p99 of a time of samples as json object.
+	 *
+	 * @param os Stream where write.
+	 * @param time The sample time member to use.
+	 */
+	void	writeJsonPercentiles(std::ostream &os, double FrameSample::*time) const;
+	/**
+	 * @brief Write samples as csv.
+	 *
+	 * @param os Stream where write.
+	 */
+	void	writeCsv(std::ostream &os) const;
+	/**
+	 * @brief Write samples as json.
+	 *
+	 * @param os Stream where write.
+	 */
+	void	writeJson(std::ostream &os) const;
+};
+
+//**** FUNCTIONS ***************************************************************
+
+#endif
@@ -0,0 +1,154 @@
+#include <program/benchmark/CameraPath.hpp>
+
+#include <program/parsing/string.hpp>
+
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+
+CameraPath::CameraPath(void)
+{
+}
+
+
+CameraPath::CameraPath(const CameraPath &obj)
+{
+	this->keyframes = obj.keyframes;
+}
+
+//---- Destructor --------------------------------------------------------------
+
+CameraPath::~CameraPath()
+{
+}
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+
+float	CameraPath::getDuration(void) const
+{
+	if (this->keyframes.empty())
+		return (0.0f);
+	return (this->keyframes.back().time);
+}
+
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+
+CameraPath	&CameraPath::operator=(const CameraPath &obj)
+{
+	if (this == &obj)
+		return (*this);
+
+	this->keyframes = obj.keyframes;
+
+	return (*this);
+}
+
+//**** PUBLIC METHODS **********************************************************
+
+void	CameraPath::addKeyframe(const CameraKeyframe &keyframe)
+{
+	if (!this->keyframes.empty() && keyframe.time < this->keyframes.back().time)
+		throw std::runtime_error("Camera path keyframes must be sorted by time");
+
+	this->keyframes.push_back(keyframe);
+}
+
+
+void	CameraPath::load(const std::string &path)
+{
+	std::ifstream	file(path);
+	std::string		line;
+	int				lineId = 0;
+
+	if (!file.is_open())
+		throw std::runtime_error("Can't open camera path " + path);
+
+	this->keyframes.clear();
+	while (std::getline(file, line))
+	{
+		lineId++;
+
+		std::vector<std::string_view>	words = splitView(line, ' ');
+		if (words.empty() || words[0][0] == '#')
+			continue ;
+
+		CameraKeyframe	keyframe;
+		if (words.size() != 6
+			|| !strToFloat(words[0], keyframe.time)
+			|| !strToFloat(words[1], keyframe.position.x)
+			|| !strToFloat(words[2], keyframe.position.y)
+			|| !strToFloat(words[3], keyframe.position.z)
+			|| !strToFloat(words[4], keyframe.pitch)
+			|| !strToFloat(words[5], keyframe.yaw))
+			throw std::runtime_error("Invalid keyframe at line " + std::to_string(lineId)
+										+ " of camera path " + path);
+
+		this->addKeyframe(keyframe);
+	}
+
+	if (this->keyframes.empty())
+		throw std::runtime_error("Camera path " + path + " has no keyframe");
+}
+
+
+void	CameraPath::apply(Camera &camera, float time) const
+{
+	if (this->keyframes.empty())
+		return ;
+
+	// Find the first keyframe after time
+	size_t	next = 0;
+	while (next < this->keyframes.size() && this->keyframes[next].time <= time)
+		next++;
+
+	if (next == 0 || next == this->keyframes.size())
+	{
+		const CameraKeyframe	&keyframe = this->keyframes[next == 0 ? 0 : next - 1];
+
+		camera.setPosition(keyframe.position);
+		camera.setRotation(keyframe.pitch, keyframe.yaw, 0.0f);
+		return ;
+	}
+
+	const CameraKeyframe	&a = this->keyframes[next - 1];
+	const CameraKeyframe	&b = this->keyframes[next];
+	float					t = (time - a.time) / (b.time - a.time);
+
+	camera.setPosition(a.position + (b.position - a.position) * t);
+	camera.setRotation(a.pitch + (b.pitch - a.pitch) * t,
+						a.yaw + (b.yaw - a.yaw) * t, 0.0f);
+}
+
+//**** STATIC METHODS **********************************************************
+
+CameraPath	CameraPath::createDefault(void)
+{
+	CameraPath	path;
+	const int	nbKeyframes = 16;
+	const float	duration = 8.0f;
+	const float	radius = 2.0f;
+
+	// Turn around the origin, looking at it
+	for (int i = 0; i <= nbKeyframes; i++)
+	{
+		float	angle = 360.0f * i / nbKeyframes;
+		float	radian = gm::radians(angle);
+
+		path.addKeyframe({
+			duration * i / nbKeyframes,
+			gm::Vec3f(cosf(radian) * radius, 0.8f, sinf(radian) * radius),
+			-20.0f,
+			angle + 180.0f});
+	}
+
+	return (path);
+}
+
+//**** PRIVATE METHODS *********************************************************
+//**** FUNCTIONS ***************************************************************
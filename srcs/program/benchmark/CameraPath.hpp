@@ -0,0 +1,117 @@
+#ifndef CAMERA_PATH_HPP
+# define CAMERA_PATH_HPP
+
+# include <defineCore.hpp>
+# include <engine/camera/Camera.hpp>
+
+# include <gmath.hpp>
+# include <string>
+# include <vector>
+
+/**
+ * @brief Struct for a camera position and rotation at a given time.
+ */
+struct CameraKeyframe
+{
+	float		time;
+	gm::Vec3f	position;
+	float		pitch;
+	float		yaw;
+};
+
+/**
+ * @brief Class for a camera path, linearly interpolated between keyframes.
+ * Used to replay the same camera movements between runs.
+ */
+class CameraPath
+{
+public:
+//**** PUBLIC ATTRIBUTS ********************************************************
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Default contructor of CameraPath class.
+	 *
+	 * @return The default CameraPath, without keyframes.
+	 */
+	CameraPath(void);
+	/**
+	 * @brief Copy constructor of CameraPath class.
+	 *
+	 * @param obj The CameraPath to copy.
+	 *
+	 * @return The CameraPath copied from parameter.
+	 */
+	CameraPath(const CameraPath &obj);
+
+//---- Destructor --------------------------------------------------------------
+	/**
+	 * @brief Destructor of CameraPath class.
+	 */
+	~CameraPath();
+
+//**** ACCESSORS ***************************************************************
+//---- Getters -----------------------------------------------------------------
+	/**
+	 * @brief Getter of path duration.
+	 *
+	 * @return Time of the last keyframe, in second.
+	 */
+	float	getDuration(void) const;
+
+//---- Setters -----------------------------------------------------------------
+//---- Operators ---------------------------------------------------------------
+	/**
+	 * @brief Copy operator of CameraPath class.
+	 *
+	 * @param obj The CameraPath to copy.
+	 *
+	 * @return The CameraPath copied from parameter.
+	 */
+	CameraPath	&operator=(const CameraPath &obj);
+
+//**** PUBLIC METHODS **********************************************************
+	/**
+	 * @brief Add a keyframe. Keyframes must be added by increasing time.
+	 *
+	 * @param keyframe The keyframe to add.
+	 *
+	 * @exception Throw an runtime_error if keyframe is before the last one.
+	 */
+	void	addKeyframe(const CameraKeyframe &keyframe);
+	/**
+	 * @brief Load keyframes from a file. Each line is
+	 * `time x y z pitch yaw`, empty lines and lines starting by # are skipped.
+	 *
+	 * @param path Path of the file.
+	 *
+	 * @exception Throw an runtime_error if the file can't be read or is invalid.
+	 */
+	void	load(const std::string &path);
+	/**
+	 * @brief Move camera to the path position at a time. Time out of the path
+	 * is clamped.
+	 *
+	 * @param camera The camera to move.
+	 * @param time Time in second since path start.
+	 */
+	void	apply(Camera &camera, float time) const;
+
+//**** STATIC METHODS **********************************************************
+	/**
+	 * @brief Create the default scripted path, a turn around the origin.
+	 *
+	 * @return The default path.
+	 */
+	static CameraPath	createDefault(void);
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+	std::vector<CameraKeyframe>	keyframes;
+
+//**** PRIVATE METHODS *********************************************************
+};
+
+//**** FUNCTIONS ***************************************************************
+
+#endif
@@ -0,0 +1,85 @@
+#include <program/loop/loop.hpp>
+
+#include <program/benchmark/Benchmark.hpp>
+#include <program/benchmark/CameraPath.hpp>
+
+#include <chrono>
+
+static void	setGpuTimes(Benchmark &bench, const VulkanGpuProfiler &gpuProfiler, uint64_t firstFrame);
+
+bool	benchmark(
+			Engine &engine,
+			Mesh3D &mesh,
+			UBOMesh3D &meshUBO,
+			Shader &shader,
+			Shader &instancedShader,
+			InstanceBufferPos &instances,
+			Camera &camera,
+			int nbFrames,
+			const std::string &output,
+			const std::string &cameraPathFile)
+{
+	CameraPath			cameraPath = CameraPath::createDefault();
+	Benchmark			bench;
+	VulkanGpuProfiler	&gpuProfiler = engine.commandPool.getGpuProfiler();
+	// Profiler count frames since engine start
+	uint64_t			firstFrame = gpuProfiler.getNbFrames();
+
+	try
+	{
+		if (!cameraPathFile.empty())
+			cameraPath.load(cameraPathFile);
+
+		// Fixed delta, so every run see the same frames
+		for (int i = 0; i < nbFrames; i++)
+		{
+			TRACE_SCOPE("frame");
+
+			std::chrono::steady_clock::time_point	start = std::chrono::steady_clock::now();
+
+			cameraPath.apply(camera, i * HEADLESS_DELTA);
+			computation(engine, mesh, meshUBO, camera, HEADLESS_DELTA);
+			draw(engine, mesh, meshUBO, shader, instancedShader, instances, camera);
+
+			std::chrono::duration<double, std::milli>	cpuTime = std::chrono::steady_clock::now() - start;
+			const FrameStats	&frameStats = engine.window.getFrameStats();
+
+			// GPU times are read back MAX_FRAMES_IN_FLIGHT frames late
+			bench.addSample({cpuTime.count(), 0.0, 0.0, frameStats.nbDraws,
+							frameStats.nbTriangles, Benchmark::getProcessMemory()});
+			setGpuTimes(bench, gpuProfiler, firstFrame);
+		}
+
+		// Read back last frames once GPU is done with them
+		VulkanTimeline	&graphicsTimeline = engine.commandPool.getGraphicsTimeline();
+		graphicsTimeline.wait(graphicsTimeline.getLastValue());
+		for (uint32_t frame = 0; frame < MAX_FRAMES_IN_FLIGHT; frame++)
+		{
+			gpuProfiler.readFrame(frame);
+			setGpuTimes(bench, gpuProfiler, firstFrame);
+		}
+
+		bench.write(output);
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << "Error : " << e.what() << std::endl;
+		return (false);
+	}
+
+	bench.printSummary(std::cout);
+	return (true);
+}
+
+
+// Fill GPU times of the frame last read back by profiler
+static void	setGpuTimes(Benchmark &bench, const VulkanGpuProfiler &gpuProfiler, uint64_t firstFrame)
+{
+	uint64_t	frame = gpuProfiler.getResultsFrame();
+
+	if (frame == UINT64_MAX || frame < firstFrame)
+		return ;
+
+	bench.setGpuTimes(frame - firstFrame, gpuProfiler.getScopeTime("frame"),
+						gpuProfiler.getScopeTime("upload"));
+}
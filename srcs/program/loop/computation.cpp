@@ -3,7 +3,11 @@
 
 static void perfLog(
 				double delta,
-				Window &window);
+				Window &window,
+				const VulkanGpuProfiler &gpuProfiler);
+static void gpuProfilerLog(
+				InputManager &inputManager,
+				const VulkanGpuProfiler &gpuProfiler);
 static void cameraMovements(
 				InputManager &inputManager,
 				Camera &camera,
@@ -17,15 +21,16 @@ void	computation(
 			Camera &camera,
 			double delta)
 {
+	TRACE_SCOPE("computation");
+
 	InputManager &inputManager = engine.inputManager;
 
-	perfLog(delta, engine.window);
+	perfLog(delta, engine.window, engine.commandPool.getGpuProfiler());
+	gpuProfilerLog(inputManager, engine.commandPool.getGpuProfiler());
 
 	cameraMovements(inputManager, camera, delta);
 
 	// Update mesh ubo
-	meshUBO.model = mesh.getModel();
-	meshUBO.pos = gm::Vec4f(mesh.getPosition());
 	meshUBO.view = camera.getView();
 	meshUBO.proj = camera.getProjection();
 	meshUBO.proj.at(1, 1) *= -1;
@@ -34,7 +39,8 @@ void	computation(
 
 static void perfLog(
 				double delta,
-				Window &window)
+				Window &window,
+				const VulkanGpuProfiler &gpuProfiler)
 {
 	static double	printFpsTime = 0.0;
 	static double	minDelta = 1000.0;
@@ -57,10 +63,10 @@ static void perfLog(
 		double minFps = 1 / maxDelta;
 		double maxFps = 1 / minDelta;
 
-		char	string[50] = {0};
+		char	string[100] = {0};
 
-		sprintf(string, "fps : %7.2f | min %7.2f | max %8.2f",
-				avgFps, minFps, maxFps);
+		sprintf(string, "fps : %7.2f | min %7.2f | max %8.2f | gpu %6.2f ms",
+				avgFps, minFps, maxFps, gpuProfiler.getScopeTime("frame"));
 
 		window.setTitle(std::string(string));
 
@@ -72,6 +78,25 @@ static void perfLog(
 }
 
 
+static void gpuProfilerLog(
+				InputManager &inputManager,
+				const VulkanGpuProfiler &gpuProfiler)
+{
+	if (!inputManager.g.isPressed())
+		return ;
+
+	if (!gpuProfiler.isEnabled())
+	{
+		std::cout << "GPU profiler unavailable on this device" << std::endl;
+		return ;
+	}
+
+	std::cout << "GPU times :" << std::endl;
+	for (const GpuScopeTime &scope : gpuProfiler.getResults())
+		std::cout << "  " << scope.name << " : " << scope.time << " ms" << std::endl;
+}
+
+
 static void cameraMovements(
 				InputManager &inputManager,
 				Camera &camera,
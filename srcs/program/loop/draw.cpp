@@ -5,15 +5,37 @@ void	draw(
 			Mesh3D &mesh,
 			UBOMesh3D &meshUBO,
 			Shader &shader,
+			Shader &instancedShader,
+			InstanceBufferPos &instances,
 			Camera &camera)
 {
+	TRACE_SCOPE("draw");
+
 	// Start drawing
-	engine.window.startDraw();
+	if (!engine.window.beginFrame())
+		return ;
+
+	engine.window.beginPass();
+
+	// Mesh transform is given by push constants, instances add their own
+	PCMesh3D	meshPC;
+	meshPC.model = mesh.getModel();
+	meshPC.pos = gm::Vec4f(mesh.getPosition());
+
+	// Camera values are shared by all meshes of a shader
+	if (instances.getNbInstance() == 0)
+	{
+		shader.updateUBO(&meshUBO, 0);
+		engine.window.draw(mesh, shader, &meshPC);
+	}
+	else
+	{
+		instancedShader.updateUBO(&meshUBO, 0);
+		engine.window.drawInstanced(mesh, instances, instancedShader, &meshPC);
+	}
 
-	// Draw mesh
-	shader.updateUBO(engine.window, &meshUBO, 0);
-	engine.window.drawMesh(mesh, shader);
+	engine.window.endPass();
 
 	// End drawing
-	engine.window.endDraw(engine.context);
+	engine.window.endFrame(engine.context);
 }
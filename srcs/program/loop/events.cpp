@@ -2,6 +2,8 @@
 
 void	events(Engine &engine)
 {
+	TRACE_SCOPE("events");
+
 	// Update events
 	glfwPollEvents();
 
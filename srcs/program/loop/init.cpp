@@ -1,18 +1,27 @@
 #include <program/loop/loop.hpp>
+#include <program/parsing/model.hpp>
+
+#include <cmath>
 
 
 static void	loadTextures(Engine &engine);
-static void	loadMesh(Engine &engine, Mesh3D &mesh);
+static void	loadMesh(Engine &engine, Mesh3D &mesh, const std::string &modelPath);
+static void	loadInstances(Engine &engine, InstanceBufferPos &instances, uint32_t nbInstances);
 static void loadShaders(
 				Engine &engine,
-				Shader &Shader);
+				Shader &shader,
+				Shader &instancedShader);
 
 
 bool init(
 		Engine &engine,
 		Mesh3D &mesh,
 		Shader &shader,
-		Camera &camera)
+		Shader &instancedShader,
+		InstanceBufferPos &instances,
+		Camera &camera,
+		const std::string &modelPath,
+		uint32_t nbInstances)
 {
 	camera.setPosition(gm::Vec3f(0.41f, 0.77f, 1.67f));
 	camera.setRotation(-20.88f, -95.34f, 0.0f);
@@ -28,14 +37,27 @@ bool init(
 		// Vulkan attributs creation
 		engine.textureManager.createAllImages(engine);
 
-		loadMesh(engine, mesh);
-		loadShaders(engine, shader);
+		loadMesh(engine, mesh, modelPath);
+		loadInstances(engine, instances, nbInstances);
+		loadShaders(engine, shader, instancedShader);
 	}
 	catch(const std::exception& e)
 	{
 		std::cerr << "Error : " << e.what() << std::endl;
 		return (false);
 	}
+
+	// Hot reload is only for development, run without it if sources are missing
+	try
+	{
+		engine.shaderWatcher.init(SHADER_SRC_DIR, SHADER_BIN_DIR);
+		engine.shaderWatcher.addShader(shader);
+		engine.shaderWatcher.addShader(instancedShader);
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << "Warning : shader hot reload disabled : " << e.what() << std::endl;
+	}
 	return (true);
 }
 
@@ -46,8 +68,17 @@ static void	loadTextures(Engine &engine)
 }
 
 
-static void	loadMesh(Engine &engine, Mesh3D &mesh)
+static void	loadMesh(Engine &engine, Mesh3D &mesh, const std::string &modelPath)
 {
+	if (!modelPath.empty())
+	{
+		mesh = loadObj(modelPath);
+		mesh.createBuffers(engine.commandPool);
+		// Model is never edited, only gpu buffers are needed
+		mesh.releaseCpuData();
+		return ;
+	}
+
 	std::vector<Vertex> vertices;
 	std::vector<uint32_t> indices;
 
@@ -105,18 +136,45 @@ static void	loadMesh(Engine &engine, Mesh3D &mesh)
 		20, 22, 23,
 	};
 
-	mesh = Mesh3D(vertices, indices);
+	mesh = Mesh3D(std::move(vertices), std::move(indices));
 	mesh.createBuffers(engine.commandPool);
 }
 
 
+static void	loadInstances(Engine &engine, InstanceBufferPos &instances, uint32_t nbInstances)
+{
+	if (nbInstances == 0)
+		return ;
+
+	std::vector<InstancePos>	positions;
+	uint32_t					side = static_cast<uint32_t>(std::ceil(std::sqrt(nbInstances)));
+	float						offset = (side - 1) * INSTANCES_SPACING / 2.0f;
+
+	// Square grid centered on mesh, last row may be incomplete
+	for (uint32_t i = 0; i < nbInstances; i++)
+		positions.push_back(InstancePos(
+			gm::Vec3f((i % side) * INSTANCES_SPACING - offset, 0.0f,
+						(i / side) * INSTANCES_SPACING - offset), 1.0f));
+
+	instances = InstanceBufferPos(std::move(positions));
+	instances.createBuffer(engine.commandPool);
+}
+
+
 static void loadShaders(
 				Engine &engine,
-				Shader &shader)
+				Shader &shader,
+				Shader &instancedShader)
 {
-	std::vector<UBOType>	uboTypes = {{sizeof(UBOMesh3D), UBO_VERTEX}};
+	std::vector<UBOType>			uboTypes = {{sizeof(UBOMesh3D), UBO_VERTEX}};
+	std::vector<PushConstantType>	pushConstantTypes = {{sizeof(PCMesh3D), UBO_VERTEX}};
 	shader.init<Vertex>(
 					engine, FCUL_COUNTER, DRAW_POLYGON,
 					"shadersbin/mesh_vert.spv", "shadersbin/mesh_frag.spv",
-					uboTypes, {"duckSpaceship"});
+					uboTypes, {"duckSpaceship"}, pushConstantTypes);
+	// Same mesh and textures, with per instance position and scale at binding 1
+	instancedShader.init<Vertex, InstancePos>(
+					engine, FCUL_COUNTER, DRAW_POLYGON,
+					"shadersbin/mesh_instanced_vert.spv", "shadersbin/mesh_frag.spv",
+					uboTypes, {"duckSpaceship"}, pushConstantTypes);
 }
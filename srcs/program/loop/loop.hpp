@@ -3,10 +3,12 @@
 
 # include <define.hpp>
 # include <engine/engine.hpp>
+# include <engine/trace/Trace.hpp>
 # include <engine/camera/Camera.hpp>
 # include <engine/window/Window.hpp>
 # include <engine/shader/Shader.hpp>
 # include <engine/mesh/Mesh.hpp>
+# include <engine/mesh/InstanceBuffer.hpp>
 # include <engine/inputs/InputManager.hpp>
 # include <engine/vulkan/VulkanContext.hpp>
 # include <engine/textures/TextureManager.hpp>
@@ -18,7 +20,11 @@
  * @param engine Engine to init.
  * @param mesh Mesh to init.
  * @param shader Shader to init.
+ * @param instancedShader Shader to init, for instanced draw of mesh.
+ * @param instances Instances to init.
  * @param camera Camera to init.
+ * @param modelPath Obj file to load, a cube is used if empty.
+ * @param nbInstances Number of instances of mesh, 0 to draw it once without instancing.
  *
  * @return True if the init succeed, false else.
  */
@@ -26,7 +32,11 @@ bool init(
 			Engine &engine,
 			Mesh3D &mesh,
 			Shader &shader,
-			Camera &camera);
+			Shader &instancedShader,
+			InstanceBufferPos &instances,
+			Camera &camera,
+			const std::string &modelPath,
+			uint32_t nbInstances);
 /**
  * @brief Update envents of program.
  *
@@ -56,6 +66,8 @@ void	computation(
  * @param mesh Mesh to draw.
  * @param meshUBO UBO of the mesh.
  * @param shader Shader used for draw mesh.
+ * @param instancedShader Shader used for draw mesh instances.
+ * @param instances Instances of mesh, mesh is drawn once if empty.
  * @param camera Camera used for draw.
  */
 void	draw(
@@ -63,7 +75,37 @@ void	draw(
 			Mesh3D &mesh,
 			UBOMesh3D &meshUBO,
 			Shader &shader,
+			Shader &instancedShader,
+			InstanceBufferPos &instances,
 			Camera &camera);
+/**
+ * @brief Render frames following a camera path with a fixed delta, and write
+ * per frame measures.
+ *
+ * @param engine Engine struct, should be headless.
+ * @param mesh Mesh to draw.
+ * @param meshUBO UBO of the mesh.
+ * @param shader Shader used for draw mesh.
+ * @param instancedShader Shader used for draw mesh instances.
+ * @param instances Instances of mesh, mesh is drawn once if empty.
+ * @param camera Camera moved along the path.
+ * @param nbFrames Number of frames to render.
+ * @param output Path of the csv or json file to write.
+ * @param cameraPathFile Path of the camera path file, empty for default path.
+ *
+ * @return True if the benchmark succeed, false else.
+ */
+bool	benchmark(
+			Engine &engine,
+			Mesh3D &mesh,
+			UBOMesh3D &meshUBO,
+			Shader &shader,
+			Shader &instancedShader,
+			InstanceBufferPos &instances,
+			Camera &camera,
+			int nbFrames,
+			const std::string &output,
+			const std::string &cameraPathFile);
 
 
 #endif
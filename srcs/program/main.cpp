@@ -13,58 +13,121 @@
 #include <program/loop/loop.hpp>
 
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
 
-int	main(void)
+int	main(int argc, char **argv)
 {
-	if (!glfwInit())
+	// Model : ./ft_vox [model.obj] ...
+	// Headless mode : ./ft_vox [model.obj] --headless [nbFrames] [output] [nbInstances]
+	// Benchmark mode : ./ft_vox [model.obj] --benchmark [nbFrames] [output] [cameraPath] [nbInstances]
+	const char	*modelPath = "";
+	if (argc > 1 && strncmp(argv[1], "--", 2) != 0)
+	{
+		modelPath = argv[1];
+		argc--;
+		argv++;
+	}
+
+	bool		bench = argc > 1 && strcmp(argv[1], "--benchmark") == 0;
+	bool		headless = bench || (argc > 1 && strcmp(argv[1], "--headless") == 0);
+	int			nbFrames = argc > 2 ? atoi(argv[2]) : HEADLESS_NB_FRAMES;
+	const char	*output = argc > 3 ? argv[3] : (bench ? BENCHMARK_OUTPUT : HEADLESS_OUTPUT);
+	const char	*cameraPath = bench && argc > 4 ? argv[4] : "";
+	int			instancesArg = bench ? 5 : 4;
+	int			nbInstances = headless && argc > instancesArg ? atoi(argv[instancesArg]) : 0;
+
+	if (!headless && !glfwInit())
 	{
 		std::cerr << "Error : GLFW init failed" << std::endl;
 		return (1);
 	}
 
-	Engine		engine;
-	Camera		camera;
-	Shader		shader;
-	Mesh3D		mesh;
-	UBOMesh3D	meshUBO;
+	Engine				engine(headless);
+	Camera				camera;
+	Shader				shader;
+	Shader				instancedShader;
+	Mesh3D				mesh;
+	InstanceBufferPos	instances;
+	UBOMesh3D			meshUBO;
 
-	if (!init(engine, mesh, shader, camera))
+	if (!init(engine, mesh, shader, instancedShader, instances, camera, modelPath,
+				nbInstances > 0 ? nbInstances : 0))
 	{
 		// Wait all vulkan tasks
 		vkDeviceWaitIdle(engine.context.getDevice());
 
 		// Destroy vulkans attributs
 		mesh.destroy();
+		instances.destroy();
 		shader.destroy(engine);
+		instancedShader.destroy(engine);
 
 		// Terminate engine and glfw
 		destroyEngine(engine);
-		glfwTerminate();
+		if (!headless)
+			glfwTerminate();
 
 		return (1);
 	}
 
-	// Main loop
-	double	delta;
-	double	currentTime = 0;
-	double	lastTime = 0;
-	while (!glfwWindowShouldClose(engine.glfwWindow))
+	int	status = 0;
+	if (bench)
+	{
+		if (!benchmark(engine, mesh, meshUBO, shader, instancedShader, instances, camera,
+						nbFrames, output, cameraPath))
+			status = 1;
+	}
+	else if (headless)
+	{
+		// Render a fixed number of frames, then save the last one
+		for (int i = 0; i < nbFrames; i++)
+		{
+			TRACE_SCOPE("frame");
+
+			computation(engine, mesh, meshUBO, camera, HEADLESS_DELTA);
+			draw(engine, mesh, meshUBO, shader, instancedShader, instances, camera);
+		}
+
+		try
+		{
+			engine.window.saveFrame(output);
+		}
+		catch(const std::exception& e)
+		{
+			std::cerr << "Error : " << e.what() << std::endl;
+			status = 1;
+		}
+	}
+	else
 	{
-		currentTime = glfwGetTime();
-		delta = currentTime - lastTime;
-		lastTime = currentTime;
+		// Main loop
+		double	delta;
+		double	currentTime = 0;
+		double	lastTime = 0;
+		while (!glfwWindowShouldClose(engine.glfwWindow))
+		{
+			TRACE_SCOPE("frame");
 
-		events(engine);
+			currentTime = glfwGetTime();
+			delta = currentTime - lastTime;
+			lastTime = currentTime;
 
-		// Close window on escape
-		if (engine.inputManager.escape.isPressed())
-			break;
+			events(engine);
 
-		// Compute part
-		computation(engine, mesh, meshUBO, camera, delta);
+			// Close window on escape
+			if (engine.inputManager.escape.isPressed())
+				break;
 
-		// Drawing part
-		draw(engine, mesh, meshUBO, shader, camera);
+			// Swap pipelines of recompiled shaders before drawing
+			engine.shaderWatcher.reloadShaders(engine);
+
+			// Compute part
+			computation(engine, mesh, meshUBO, camera, delta);
+
+			// Drawing part
+			draw(engine, mesh, meshUBO, shader, instancedShader, instances, camera);
+		}
 	}
 
 	// Wait all vulkan tasks
@@ -72,11 +135,23 @@ int	main(void)
 
 	// Destroy vulkans attributs
 	mesh.destroy();
+	instances.destroy();
 	shader.destroy(engine);
+	instancedShader.destroy(engine);
 
 	// Terminate engine and glfw
 	destroyEngine(engine);
-	glfwTerminate();
+	if (!headless)
+		glfwTerminate();
+
+	try
+	{
+		TRACE_SAVE(TRACE_OUTPUT);
+	}
+	catch(const std::exception& e)
+	{
+		std::cerr << "Error : " << e.what() << std::endl;
+	}
 
-	return (0);
+	return (status);
 }
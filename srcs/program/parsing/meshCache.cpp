@@ -0,0 +1,247 @@
+#include <program/parsing/meshCache.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//**** STATIC STRUCTS **********************************************************
+
+/**
+ * @brief Struct at the start of cache file, followed by vertices then indices.
+ */
+struct MeshCacheHeader
+{
+	char		magic[4];
+	uint32_t	version;
+	uint32_t	vertexSize;
+	uint32_t	indexSize;
+	uint64_t	sourceSize;
+	int64_t		sourceMtime;
+	uint64_t	sourceHash;
+	uint64_t	nbVertex;
+	uint64_t	nbIndex;
+};
+
+/**
+ * @brief Struct for a read only mapped file.
+ */
+struct MappedFile
+{
+	const char	*data;
+	size_t		size;
+	int64_t		mtime;
+};
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+
+static const char	meshCacheMagic[4] = {'V', 'X', 'M', 'C'};
+
+static bool		mapFile(const std::string &path, MappedFile &file);
+static void		unmapFile(MappedFile &file);
+static bool		statFile(const std::string &path, uint64_t &size, int64_t &mtime);
+static void		updateSourceMtime(const std::string &cachePath, int64_t mtime);
+static uint64_t	hashData(const char *data, size_t size);
+
+//**** FUNCTIONS ***************************************************************
+
+std::string	getMeshCachePath(const std::string &sourcePath)
+{
+	return (sourcePath + MESH_CACHE_EXTENSION);
+}
+
+
+bool	loadMeshCache(const std::string &sourcePath, std::vector<Vertex> &vertices, std::vector<uint32_t> &indices)
+{
+	uint64_t	sourceSize;
+	int64_t		sourceMtime;
+	if (!statFile(sourcePath, sourceSize, sourceMtime))
+		return (false);
+
+	MappedFile	cache;
+	if (!mapFile(getMeshCachePath(sourcePath), cache))
+		return (false);
+
+	MeshCacheHeader	header;
+	if (cache.size < sizeof(header))
+	{
+		unmapFile(cache);
+		return (false);
+	}
+	memcpy(&header, cache.data, sizeof(header));
+
+	size_t	verticesSize = header.nbVertex * sizeof(Vertex);
+	size_t	indicesSize = header.nbIndex * sizeof(uint32_t);
+
+	if (memcmp(header.magic, meshCacheMagic, sizeof(meshCacheMagic)) != 0
+		|| header.version != MESH_CACHE_VERSION
+		|| header.vertexSize != sizeof(Vertex)
+		|| header.indexSize != sizeof(uint32_t)
+		|| header.sourceSize != sourceSize
+		|| cache.size != sizeof(header) + verticesSize + indicesSize)
+	{
+		unmapFile(cache);
+		return (false);
+	}
+
+	// Modification time changed but content may not (checkout, copy), compare hash
+	if (header.sourceMtime != sourceMtime)
+	{
+		MappedFile	source;
+		bool		sameSource = mapFile(sourcePath, source)
+								&& hashData(source.data, source.size) == header.sourceHash;
+
+		unmapFile(source);
+		if (!sameSource)
+		{
+			unmapFile(cache);
+			return (false);
+		}
+
+		// Next runs trust the new modification time, without hashing again
+		updateSourceMtime(getMeshCachePath(sourcePath), sourceMtime);
+	}
+
+	// Arrays are in upload layout, copied as is
+	const char	*data = cache.data + sizeof(header);
+	vertices.resize(header.nbVertex);
+	memcpy(static_cast<void *>(vertices.data()), data, verticesSize);
+	indices.resize(header.nbIndex);
+	memcpy(indices.data(), data + verticesSize, indicesSize);
+
+	unmapFile(cache);
+	return (true);
+}
+
+
+void	saveMeshCache(const std::string &sourcePath, const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices)
+{
+	MappedFile	source;
+	if (!mapFile(sourcePath, source))
+		throw std::runtime_error("Can't read model " + sourcePath);
+
+	MeshCacheHeader	header;
+	memcpy(header.magic, meshCacheMagic, sizeof(meshCacheMagic));
+	header.version = MESH_CACHE_VERSION;
+	header.vertexSize = sizeof(Vertex);
+	header.indexSize = sizeof(uint32_t);
+	header.sourceSize = source.size;
+	header.sourceMtime = source.mtime;
+	header.sourceHash = hashData(source.data, source.size);
+	header.nbVertex = vertices.size();
+	header.nbIndex = indices.size();
+	unmapFile(source);
+
+	// Write in a temp file then rename, so a cache is never read half written
+	std::string		cachePath = getMeshCachePath(sourcePath);
+	std::string		tmpPath = cachePath + ".tmp";
+	std::ofstream	file(tmpPath, std::ios::binary | std::ios::trunc);
+
+	if (!file.is_open())
+		throw std::runtime_error("Can't create mesh cache " + tmpPath);
+
+	file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char *>(vertices.data()), vertices.size() * sizeof(Vertex));
+	file.write(reinterpret_cast<const char *>(indices.data()), indices.size() * sizeof(uint32_t));
+	file.close();
+
+	if (file.fail() || std::rename(tmpPath.c_str(), cachePath.c_str()) != 0)
+	{
+		std::remove(tmpPath.c_str());
+		throw std::runtime_error("Can't write mesh cache " + cachePath);
+	}
+}
+
+//**** STATIC FUNCTIONS ********************************************************
+
+static bool	mapFile(const std::string &path, MappedFile &file)
+{
+	file.data = NULL;
+	file.size = 0;
+	file.mtime = 0;
+
+	int	fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return (false);
+
+	struct stat	fileStat;
+	if (fstat(fd, &fileStat) != 0)
+	{
+		close(fd);
+		return (false);
+	}
+
+	file.size = static_cast<size_t>(fileStat.st_size);
+	file.mtime = fileStat.st_mtim.tv_sec * 1000000000LL + fileStat.st_mtim.tv_nsec;
+
+	if (file.size > 0)
+	{
+		void	*data = mmap(NULL, file.size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			close(fd);
+			return (false);
+		}
+		madvise(data, file.size, MADV_SEQUENTIAL);
+		file.data = static_cast<const char *>(data);
+	}
+	close(fd);
+
+	return (true);
+}
+
+
+static void	unmapFile(MappedFile &file)
+{
+	if (file.data != NULL)
+		munmap(const_cast<char *>(file.data), file.size);
+
+	file.data = NULL;
+	file.size = 0;
+}
+
+
+static bool	statFile(const std::string &path, uint64_t &size, int64_t &mtime)
+{
+	struct stat	fileStat;
+
+	if (stat(path.c_str(), &fileStat) != 0)
+		return (false);
+
+	size = static_cast<uint64_t>(fileStat.st_size);
+	mtime = fileStat.st_mtim.tv_sec * 1000000000LL + fileStat.st_mtim.tv_nsec;
+	return (true);
+}
+
+
+// Failure only cost a hash on next load, cache is still valid
+static void	updateSourceMtime(const std::string &cachePath, int64_t mtime)
+{
+	int	fd = open(cachePath.c_str(), O_WRONLY);
+	if (fd < 0)
+		return ;
+
+	if (pwrite(fd, &mtime, sizeof(mtime), offsetof(MeshCacheHeader, sourceMtime)) != sizeof(mtime))
+		std::cerr << "Warning : Can't update mesh cache " << cachePath << std::endl;
+	close(fd);
+}
+
+
+// FNV-1a, only to detect a changed model
+static uint64_t	hashData(const char *data, size_t size)
+{
+	uint64_t	hash = 14695981039346656037ULL;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= static_cast<unsigned char>(data[i]);
+		hash *= 1099511628211ULL;
+	}
+	return (hash);
+}
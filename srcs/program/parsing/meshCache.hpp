@@ -0,0 +1,41 @@
+#ifndef MESH_CACHE_HPP
+# define MESH_CACHE_HPP
+
+# include <defineCore.hpp>
+# include <engine/mesh/Vertex.hpp>
+
+# include <string>
+# include <vector>
+
+/**
+ * @brief Get the cache file path of a model.
+ *
+ * @param sourcePath Path of the model file.
+ *
+ * @return Path of the cache file, next to the model.
+ */
+std::string	getMeshCachePath(const std::string &sourcePath);
+/**
+ * @brief Load vertices and indices of a model from its cache file. Cache is
+ * used if its version and vertex size match, and the model has the same size
+ * and modification time, or the same content hash.
+ *
+ * @param sourcePath Path of the model file.
+ * @param vertices Vector filled with cached vertices.
+ * @param indices Vector filled with cached indices.
+ *
+ * @return True if cache was loaded, false if it is missing, outdated or invalid.
+ */
+bool	loadMeshCache(const std::string &sourcePath, std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+/**
+ * @brief Write vertices and indices of a model in its cache file.
+ *
+ * @param sourcePath Path of the model file.
+ * @param vertices Vertices to cache.
+ * @param indices Indices to cache.
+ *
+ * @exception Throw an runtime_error if the model or the cache file can't be accessed.
+ */
+void	saveMeshCache(const std::string &sourcePath, const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices);
+
+#endif
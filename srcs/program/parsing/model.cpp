@@ -0,0 +1,40 @@
+#include <program/parsing/model.hpp>
+#include <program/parsing/obj.hpp>
+#include <program/parsing/meshCache.hpp>
+#include <engine/mesh/MeshOptimizer.hpp>
+
+#include <iostream>
+#include <stdexcept>
+
+//**** FUNCTIONS ***************************************************************
+
+Mesh3D	loadObj(const std::string &path)
+{
+	std::vector<Vertex>		vertices;
+	std::vector<uint32_t>	indices;
+
+	if (loadMeshCache(path, vertices, indices))
+		return (Mesh3D(std::move(vertices), std::move(indices)));
+
+	parseObj(path, vertices, indices);
+
+	if (indices.empty())
+		throw std::runtime_error("Obj file " + path + " has no face");
+
+	// Optimized once, cache keep optimized order
+	MeshOptimizerStats	stats = optimizeMesh(vertices, indices);
+	std::cout << "Mesh '" << path << "' optimized, ACMR " << stats.acmrBefore
+				<< " -> " << stats.acmrAfter << std::endl;
+
+	// Model is still usable without cache, next run will parse it again
+	try
+	{
+		saveMeshCache(path, vertices, indices);
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << "Warning : " << e.what() << std::endl;
+	}
+
+	return (Mesh3D(std::move(vertices), std::move(indices)));
+}
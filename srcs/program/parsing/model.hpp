@@ -0,0 +1,21 @@
+#ifndef MODEL_HPP
+# define MODEL_HPP
+
+# include <engine/mesh/Mesh.hpp>
+
+# include <string>
+
+/**
+ * @brief Load a Wavefront obj file into a mesh. The binary cache next to
+ * the file is used if up to date, else the file is parsed, optimized for
+ * vertex cache and the cache is written.
+ *
+ * @param path Path of the obj file.
+ *
+ * @return The mesh, without buffers.
+ *
+ * @exception Throw an runtime_error if the file can't be read or is invalid.
+ */
+Mesh3D	loadObj(const std::string &path);
+
+#endif
@@ -0,0 +1,318 @@
+#include <program/parsing/obj.hpp>
+
+#include <charconv>
+#include <stdexcept>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//**** STATIC STRUCTS **********************************************************
+
+/**
+ * @brief Struct for a face corner, as indices into obj arrays. -1 if absent.
+ */
+struct ObjCorner
+{
+	int	pos;
+	int	tex;
+	int	nrm;
+};
+
+/**
+ * @brief Struct for the parser state.
+ */
+struct ObjParser
+{
+	const char					*cursor;
+	const char					*end;
+	int							line;
+	const std::string			*path;
+	std::vector<gm::Vec3f>		positions;
+	std::vector<gm::Vec2f>		texCoords;
+	std::vector<gm::Vec3f>		normals;
+	std::vector<ObjCorner>		corners;
+	// Unique vertices by hash, collisions are probed on next hash
+	std::unordered_map<std::size_t, uint32_t>	uniqueVertices;
+	std::vector<Vertex>			*vertices;
+	std::vector<uint32_t>		*indices;
+};
+
+//**** STATIC FUNCTIONS DEFINE *************************************************
+
+static void		parseData(ObjParser &parser);
+static void		parseFace(ObjParser &parser);
+static void		parseFloats(ObjParser &parser, float *values, int nbValues);
+static int		parseIndex(ObjParser &parser, int nbValues);
+static uint32_t	addVertex(ObjParser &parser, Vertex &vertex);
+static bool		isBlank(char c);
+static void		skipBlanks(ObjParser &parser);
+static void		skipLine(ObjParser &parser);
+static void		throwError(const ObjParser &parser, const std::string &message);
+
+//**** FUNCTIONS ***************************************************************
+
+void	parseObj(const std::string &path, std::vector<Vertex> &vertices, std::vector<uint32_t> &indices)
+{
+	int	fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw std::runtime_error("Can't open obj file " + path);
+
+	struct stat	fileStat;
+	if (fstat(fd, &fileStat) != 0)
+	{
+		close(fd);
+		throw std::runtime_error("Can't read obj file " + path);
+	}
+
+	size_t	size = static_cast<size_t>(fileStat.st_size);
+	void	*data = NULL;
+
+	// Map file instead of reading it, parser walks it once
+	if (size > 0)
+	{
+		data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			close(fd);
+			throw std::runtime_error("Can't map obj file " + path);
+		}
+		madvise(data, size, MADV_SEQUENTIAL);
+	}
+	close(fd);
+
+	try
+	{
+		parseObjData(std::string_view(static_cast<const char *>(data), size), path, vertices, indices);
+	}
+	catch (const std::exception &e)
+	{
+		if (data != NULL)
+			munmap(data, size);
+		throw;
+	}
+
+	if (data != NULL)
+		munmap(data, size);
+}
+
+
+void	parseObjData(std::string_view data, const std::string &path,
+						std::vector<Vertex> &vertices, std::vector<uint32_t> &indices)
+{
+	ObjParser	parser;
+	parser.cursor = data.data();
+	parser.end = parser.cursor + data.size();
+	parser.line = 1;
+	parser.path = &path;
+	parser.vertices = &vertices;
+	parser.indices = &indices;
+
+	vertices.clear();
+	indices.clear();
+
+	parseData(parser);
+}
+
+//**** STATIC FUNCTIONS ********************************************************
+
+static void	parseData(ObjParser &parser)
+{
+	while (parser.cursor < parser.end)
+	{
+		skipBlanks(parser);
+		if (parser.cursor >= parser.end)
+			break ;
+
+		const char	*keyword = parser.cursor;
+		while (parser.cursor < parser.end && !isBlank(*parser.cursor)
+				&& *parser.cursor != '\n' && *parser.cursor != '\r')
+			parser.cursor++;
+
+		size_t	keywordLen = parser.cursor - keyword;
+
+		if (keywordLen == 1 && keyword[0] == 'v')
+		{
+			float	values[3];
+			parseFloats(parser, values, 3);
+			parser.positions.push_back(gm::Vec3f(values[0], values[1], values[2]));
+		}
+		else if (keywordLen == 2 && keyword[0] == 'v' && keyword[1] == 't')
+		{
+			float	values[2];
+			parseFloats(parser, values, 2);
+			parser.texCoords.push_back(gm::Vec2f(values[0], values[1]));
+		}
+		else if (keywordLen == 2 && keyword[0] == 'v' && keyword[1] == 'n')
+		{
+			float	values[3];
+			parseFloats(parser, values, 3);
+			parser.normals.push_back(gm::Vec3f(values[0], values[1], values[2]));
+		}
+		else if (keywordLen == 1 && keyword[0] == 'f')
+			parseFace(parser);
+
+		// Comments, groups, materials and extra values are ignored
+		skipLine(parser);
+	}
+}
+
+
+static void	parseFace(ObjParser &parser)
+{
+	parser.corners.clear();
+
+	skipBlanks(parser);
+	while (parser.cursor < parser.end && *parser.cursor != '\n'
+			&& *parser.cursor != '\r' && *parser.cursor != '#')
+	{
+		ObjCorner	corner = {-1, -1, -1};
+
+		corner.pos = parseIndex(parser, static_cast<int>(parser.positions.size()));
+		if (parser.cursor < parser.end && *parser.cursor == '/')
+		{
+			parser.cursor++;
+			if (parser.cursor < parser.end && *parser.cursor != '/')
+				corner.tex = parseIndex(parser, static_cast<int>(parser.texCoords.size()));
+			if (parser.cursor < parser.end && *parser.cursor == '/')
+			{
+				parser.cursor++;
+				corner.nrm = parseIndex(parser, static_cast<int>(parser.normals.size()));
+			}
+		}
+		parser.corners.push_back(corner);
+		skipBlanks(parser);
+	}
+
+	if (parser.corners.size() < 3)
+		throwError(parser, "face needs at least 3 vertices");
+
+	// Face normal, for corners without normal
+	const gm::Vec3f	&a = parser.positions[parser.corners[0].pos];
+	const gm::Vec3f	&b = parser.positions[parser.corners[1].pos];
+	const gm::Vec3f	&c = parser.positions[parser.corners[2].pos];
+	gm::Vec3f		faceNormal = gm::normalize(gm::cross(b - a, c - a));
+
+	uint32_t	faceIndices[3];
+	for (size_t i = 0; i < parser.corners.size(); i++)
+	{
+		const ObjCorner	&corner = parser.corners[i];
+		Vertex			vertex(
+							parser.positions[corner.pos],
+							corner.nrm >= 0 ? parser.normals[corner.nrm] : faceNormal,
+							corner.tex >= 0 ? parser.texCoords[corner.tex] : gm::Vec2f(0.0f, 0.0f));
+		uint32_t		index = addVertex(parser, vertex);
+
+		// Polygons are triangulated as a fan from first corner
+		if (i < 2)
+		{
+			faceIndices[i] = index;
+			continue ;
+		}
+		faceIndices[2] = index;
+		parser.indices->insert(parser.indices->end(), faceIndices, faceIndices + 3);
+		faceIndices[1] = index;
+	}
+}
+
+
+static void	parseFloats(ObjParser &parser, float *values, int nbValues)
+{
+	for (int i = 0; i < nbValues; i++)
+	{
+		skipBlanks(parser);
+
+		// from_chars don't take leading +
+		if (parser.cursor < parser.end && *parser.cursor == '+')
+			parser.cursor++;
+
+		std::from_chars_result	result = std::from_chars(parser.cursor, parser.end, values[i]);
+		if (result.ec != std::errc())
+			throwError(parser, "invalid number");
+		parser.cursor = result.ptr;
+	}
+}
+
+
+static int	parseIndex(ObjParser &parser, int nbValues)
+{
+	int	index;
+
+	std::from_chars_result	result = std::from_chars(parser.cursor, parser.end, index);
+	if (result.ec != std::errc())
+		throwError(parser, "invalid index");
+	parser.cursor = result.ptr;
+
+	// Indices start at 1, negatives are relative to the end
+	if (index < 0)
+		index += nbValues;
+	else
+		index -= 1;
+
+	if (index < 0 || index >= nbValues)
+		throwError(parser, "index out of range");
+
+	return (index);
+}
+
+
+static uint32_t	addVertex(ObjParser &parser, Vertex &vertex)
+{
+	std::size_t	hash = vertex.getHash();
+
+	while (true)
+	{
+		auto	[it, inserted] = parser.uniqueVertices.try_emplace(
+									hash, static_cast<uint32_t>(parser.vertices->size()));
+
+		if (inserted)
+		{
+			parser.vertices->push_back(vertex);
+			return (it->second);
+		}
+
+		const Vertex	&unique = (*parser.vertices)[it->second];
+		if (unique.pos.x == vertex.pos.x && unique.pos.y == vertex.pos.y
+			&& unique.pos.z == vertex.pos.z && unique.nrm.x == vertex.nrm.x
+			&& unique.nrm.y == vertex.nrm.y && unique.nrm.z == vertex.nrm.z
+			&& unique.tex.x == vertex.tex.x && unique.tex.y == vertex.tex.y)
+			return (it->second);
+
+		// Hash collision between different vertices
+		hash++;
+	}
+}
+
+
+static bool	isBlank(char c)
+{
+	return (c == ' ' || c == '\t');
+}
+
+
+static void	skipBlanks(ObjParser &parser)
+{
+	while (parser.cursor < parser.end && isBlank(*parser.cursor))
+		parser.cursor++;
+}
+
+
+static void	skipLine(ObjParser &parser)
+{
+	while (parser.cursor < parser.end && *parser.cursor != '\n')
+		parser.cursor++;
+
+	if (parser.cursor < parser.end)
+	{
+		parser.cursor++;
+		parser.line++;
+	}
+}
+
+
+static void	throwError(const ObjParser &parser, const std::string &message)
+{
+	throw std::runtime_error("Obj file " + *parser.path + " line "
+								+ std::to_string(parser.line) + " : " + message);
+}
@@ -0,0 +1,36 @@
+#ifndef OBJ_HPP
+# define OBJ_HPP
+
+# include <defineCore.hpp>
+# include <engine/mesh/Vertex.hpp>
+
+# include <string>
+# include <string_view>
+# include <vector>
+
+/**
+ * @brief Parse a Wavefront obj file. Support v, vt, vn and polygonal f
+ * lines (fan triangulated, negative indices allowed), other lines are skipped.
+ * Identical vertices are merged. Faces without normals use the face normal.
+ *
+ * @param path Path of the obj file.
+ * @param vertices Vector filled with unique vertices.
+ * @param indices Vector filled with triangle indices.
+ *
+ * @exception Throw an runtime_error if the file can't be read or is invalid.
+ */
+void	parseObj(const std::string &path, std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+/**
+ * @brief Parse Wavefront obj data already in memory, as parseObj.
+ *
+ * @param data Content of the obj file.
+ * @param path Path of the obj file, for error messages.
+ * @param vertices Vector filled with unique vertices.
+ * @param indices Vector filled with triangle indices.
+ *
+ * @exception Throw an runtime_error if the data is invalid.
+ */
+void	parseObjData(std::string_view data, const std::string &path,
+						std::vector<Vertex> &vertices, std::vector<uint32_t> &indices);
+
+#endif
@@ -1,30 +1,128 @@
 #include <program/parsing/string.hpp>
 
+#include <charconv>
 #include <limits>
 
-std::vector<std::string> split(const std::string &s, const char c)
+//**** SPLIT ITERATOR **********************************************************
+
+SplitIterator::SplitIterator(void)
 {
-	int							i, j;
-	std::vector<std::string>	res;
+	this->separator = ' ';
+	this->ended = true;
+}
+
+
+SplitIterator::SplitIterator(std::string_view s, const char c)
+{
+	this->rest = s;
+	this->separator = c;
+	this->ended = false;
+	this->next();
+}
+
+
+SplitIterator::reference	SplitIterator::operator*(void) const
+{
+	return (this->token);
+}
+
+
+SplitIterator::pointer	SplitIterator::operator->(void) const
+{
+	return (&this->token);
+}
+
+
+SplitIterator	&SplitIterator::operator++(void)
+{
+	this->next();
+	return (*this);
+}
+
+
+SplitIterator	SplitIterator::operator++(int)
+{
+	SplitIterator	tmp = *this;
+
+	this->next();
+	return (tmp);
+}
+
+
+bool	SplitIterator::operator==(const SplitIterator &obj) const
+{
+	if (this->ended || obj.ended)
+		return (this->ended == obj.ended);
+
+	return (this->rest.data() == obj.rest.data() && this->token.data() == obj.token.data());
+}
+
+
+bool	SplitIterator::operator!=(const SplitIterator &obj) const
+{
+	return (!(*this == obj));
+}
 
-	i = 0;
-	while (s[i] != '\0')
+
+void	SplitIterator::next(void)
+{
+	size_t	start = this->rest.find_first_not_of(this->separator);
+
+	if (start == std::string_view::npos)
 	{
-		while (s[i] == c)
-			i++;
-		if (s[i] == '\0')
-			break ;
-		j = 0;
-		while (s[i + j] != c && s[i + j] != '\0')
-			j++;
-		res.push_back(s.substr(i, j));
-		i += j;
+		this->ended = true;
+		return ;
 	}
+
+	size_t	len = this->rest.find(this->separator, start);
+	if (len != std::string_view::npos)
+		len -= start;
+
+	this->token = this->rest.substr(start, len);
+	this->rest.remove_prefix(start + this->token.size());
+}
+
+
+SplitIterator	SplitRange::begin(void) const
+{
+	return (SplitIterator(this->s, this->c));
+}
+
+
+SplitIterator	SplitRange::end(void) const
+{
+	return (SplitIterator());
+}
+
+//**** FUNCTIONS ***************************************************************
+
+std::vector<std::string> split(std::string_view s, const char c)
+{
+	std::vector<std::string>	res;
+
+	for (std::string_view token : splitLazy(s, c))
+		res.emplace_back(token);
+	return (res);
+}
+
+
+std::vector<std::string_view> splitView(std::string_view s, const char c)
+{
+	std::vector<std::string_view>	res;
+
+	for (std::string_view token : splitLazy(s, c))
+		res.push_back(token);
 	return (res);
 }
 
 
-bool	strToInt(const std::string &s, int &res)
+SplitRange	splitLazy(std::string_view s, const char c)
+{
+	return (SplitRange{s, c});
+}
+
+
+bool	strToInt(std::string_view s, int &res)
 {
 	if (s.empty())
 		return (false);
@@ -50,18 +148,22 @@ bool	strToInt(const std::string &s, int &res)
 	if (tmp - start > 10)
 		return (false);
 
-	long	value = std::stol(s.c_str());
+	// from_chars don't take leading +
+	if (s[0] == '+')
+		s.remove_prefix(1);
 
-	// Check overflow by value
-	if (value > INT32_MAX || value < INT32_MIN)
+	// Check overflow by value, and sign without digits
+	int						value;
+	std::from_chars_result	result = std::from_chars(s.data(), s.data() + s.size(), value);
+	if (result.ec != std::errc() || result.ptr != s.data() + s.size())
 		return (false);
 
 	// Value is an integer
-	res = static_cast<int>(value);
+	res = value;
 	return (true);
 }
 
-bool	strToFloat(const std::string &s, float &res)
+bool	strToFloat(std::string_view s, float &res)
 {
 	if (s.empty())
 		return (false);
@@ -96,7 +198,15 @@ bool	strToFloat(const std::string &s, float &res)
 	if (tmp - start > 20)
 		return (false);
 
-	double	value = std::stod(s.c_str());
+	// from_chars don't take leading +
+	if (s[0] == '+')
+		s.remove_prefix(1);
+
+	// Parse as double, locale independent, to check float overflow after
+	double					value;
+	std::from_chars_result	result = std::from_chars(s.data(), s.data() + s.size(), value);
+	if (result.ec != std::errc() || result.ptr != s.data() + s.size())
+		return (false);
 
 	// Check overflow by value
 	if (value > std::numeric_limits<float>::max() || value < -std::numeric_limits<float>::max())
@@ -108,7 +218,7 @@ bool	strToFloat(const std::string &s, float &res)
 }
 
 
-int	nbOccurences(const std::string &s, const char c)
+int	nbOccurences(std::string_view s, const char c)
 {
 	int	occurence = 0;
 
@@ -1,9 +1,91 @@
 #ifndef STRING_HPP
 # define STRING_HPP
 
+# include <cstddef>
+# include <iterator>
 # include <string>
+# include <string_view>
 # include <vector>
 
+/**
+ * @brief Iterator over the tokens of a string split by a character.
+ * Tokens are views into the string, nothing is allocated.
+ */
+class SplitIterator
+{
+public:
+	using iterator_category = std::input_iterator_tag;
+	using value_type = std::string_view;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const std::string_view *;
+	using reference = const std::string_view &;
+
+//**** INITIALISION ************************************************************
+//---- Constructors ------------------------------------------------------------
+	/**
+	 * @brief Default contructor of SplitIterator class.
+	 *
+	 * @return The end iterator.
+	 */
+	SplitIterator(void);
+	/**
+	 * @brief Contructor of SplitIterator class.
+	 *
+	 * @param s The string to split, must outlive the iterator.
+	 * @param c The char to use as separator.
+	 *
+	 * @return The iterator on first token of s.
+	 */
+	SplitIterator(std::string_view s, const char c);
+
+//**** ACCESSORS ***************************************************************
+//---- Operators ---------------------------------------------------------------
+	/**
+	 * @brief Getter of current token.
+	 *
+	 * @return The current token.
+	 */
+	reference		operator*(void) const;
+	pointer			operator->(void) const;
+	/**
+	 * @brief Go to next token.
+	 *
+	 * @return The iterator.
+	 */
+	SplitIterator	&operator++(void);
+	SplitIterator	operator++(int);
+	/**
+	 * @brief Compare iterators. Every iterator past last token is equal to end.
+	 */
+	bool			operator==(const SplitIterator &obj) const;
+	bool			operator!=(const SplitIterator &obj) const;
+
+private:
+//**** PRIVATE ATTRIBUTS *******************************************************
+	std::string_view	rest;
+	std::string_view	token;
+	char				separator;
+	bool				ended;
+
+//**** PRIVATE METHODS *********************************************************
+	/**
+	 * @brief Take next token from the rest of string, or set ended.
+	 */
+	void	next(void);
+};
+
+/**
+ * @brief Range of tokens of a string split by a character, for range for.
+ */
+struct SplitRange
+{
+	std::string_view	s;
+	char				c;
+
+	SplitIterator	begin(void) const;
+	SplitIterator	end(void) const;
+};
+
 /**
  * @brief Split a string be a character.
  *
@@ -12,7 +94,25 @@
  *
  * @return A vector of string, split by c.
  */
-std::vector<std::string> split(const std::string &s, const char c);
+std::vector<std::string> split(std::string_view s, const char c);
+/**
+ * @brief Split a string be a character, without copying tokens.
+ *
+ * @param s The string to split, must outlive the result.
+ * @param c The char to use as separator.
+ *
+ * @return A vector of views into s, split by c.
+ */
+std::vector<std::string_view> splitView(std::string_view s, const char c);
+/**
+ * @brief Split a string be a character lazily, tokens are found while iterating.
+ *
+ * @param s The string to split, must outlive the range.
+ * @param c The char to use as separator.
+ *
+ * @return A range of views into s, split by c.
+ */
+SplitRange	splitLazy(std::string_view s, const char c);
 /**
  * @brief Transform a string to an int.
  *
@@ -21,7 +121,7 @@ std::vector<std::string> split(const std::string &s, const char c);
  *
  * @return False in case of error, true else.
  */
-bool	strToInt(const std::string &s, int &res);
+bool	strToInt(std::string_view s, int &res);
 /**
  * @brief Transform a string to a float.
  *
@@ -30,7 +130,7 @@ bool	strToInt(const std::string &s, int &res);
  *
  * @return False in case of error, true else.
  */
-bool	strToFloat(const std::string &s, float &res);
+bool	strToFloat(std::string_view s, float &res);
 /**
  * @brief Count the number of occurrences of the char into the string.
  *
@@ -39,5 +139,5 @@ bool	strToFloat(const std::string &s, float &res);
  *
  * @return Number of occurrences of c in s.
  */
-int	nbOccurences(const std::string &s, const char c);
+int	nbOccurences(std::string_view s, const char c);
 #endif
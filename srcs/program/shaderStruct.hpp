@@ -17,11 +17,15 @@
 
 # include <gmath.hpp>
 
-// Uniform buffer object
+// Uniform buffer object, same for all meshes of a frame
 struct UBOMesh3D {
-	gm::Mat4f	model;
 	gm::Mat4f	view;
 	gm::Mat4f	proj;
+};
+
+// Push constants, given per mesh draw
+struct PCMesh3D {
+	gm::Mat4f	model;
 	gm::Vec4f	pos;
 };
 
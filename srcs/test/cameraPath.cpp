@@ -0,0 +1,73 @@
+#include <test/test.hpp>
+
+#include <program/benchmark/CameraPath.hpp>
+#include <engine/camera/Camera.hpp>
+
+#include <stdexcept>
+
+#define CAMERA_EPSILON 1e-4f
+
+void	testCameraPath(void)
+{
+	CameraPath	path;
+	Camera		camera;
+
+	// Empty path leave camera untouched
+	camera.setPosition(gm::Vec3f(1.0f, 2.0f, 3.0f));
+	path.apply(camera, 1.0f);
+	CHECK(camera.getPosition().x == 1.0f);
+	CHECK(path.getDuration() == 0.0f);
+
+	path.addKeyframe({0.0f, gm::Vec3f(0.0f, 0.0f, 0.0f), 0.0f, 0.0f});
+	path.addKeyframe({2.0f, gm::Vec3f(4.0f, -2.0f, 8.0f), 40.0f, 90.0f});
+	path.addKeyframe({4.0f, gm::Vec3f(4.0f, -2.0f, 0.0f), 40.0f, 180.0f});
+	CHECK(path.getDuration() == 4.0f);
+
+	// Linear interpolation between surrounding keyframes
+	path.apply(camera, 1.0f);
+	CHECK_NEAR(camera.getPosition().x, 2.0f, CAMERA_EPSILON);
+	CHECK_NEAR(camera.getPosition().y, -1.0f, CAMERA_EPSILON);
+	CHECK_NEAR(camera.getPosition().z, 4.0f, CAMERA_EPSILON);
+	CHECK_NEAR(camera.getPitch(), 20.0f, CAMERA_EPSILON);
+	CHECK_NEAR(camera.getYaw(), 45.0f, CAMERA_EPSILON);
+
+	path.apply(camera, 3.0f);
+	CHECK_NEAR(camera.getPosition().z, 4.0f, CAMERA_EPSILON);
+	CHECK_NEAR(camera.getYaw(), 135.0f, CAMERA_EPSILON);
+
+	// Exactly on a keyframe
+	path.apply(camera, 2.0f);
+	CHECK_NEAR(camera.getPosition().x, 4.0f, CAMERA_EPSILON);
+	CHECK_NEAR(camera.getYaw(), 90.0f, CAMERA_EPSILON);
+
+	// Clamped to first and last keyframes outside of path
+	path.apply(camera, -1.0f);
+	CHECK_NEAR(camera.getPosition().x, 0.0f, CAMERA_EPSILON);
+	CHECK_NEAR(camera.getPitch(), 0.0f, CAMERA_EPSILON);
+	path.apply(camera, 10.0f);
+	CHECK_NEAR(camera.getPosition().z, 0.0f, CAMERA_EPSILON);
+	CHECK_NEAR(camera.getYaw(), 180.0f, CAMERA_EPSILON);
+
+	// Keyframes must be sorted by time
+	bool	thrown = false;
+	try
+	{
+		path.addKeyframe({1.0f, gm::Vec3f(), 0.0f, 0.0f});
+	}
+	catch (const std::runtime_error &e)
+	{
+		thrown = true;
+	}
+	CHECK(thrown);
+
+	// Default path loop back to its start
+	CameraPath	defaultPath = CameraPath::createDefault();
+	Camera		start;
+	Camera		end;
+
+	defaultPath.apply(start, 0.0f);
+	defaultPath.apply(end, defaultPath.getDuration());
+	CHECK(defaultPath.getDuration() > 0.0f);
+	CHECK_NEAR(start.getPosition().x, end.getPosition().x, CAMERA_EPSILON);
+	CHECK_NEAR(start.getPosition().z, end.getPosition().z, CAMERA_EPSILON);
+}
@@ -0,0 +1,31 @@
+#include <test/grid.hpp>
+
+#include <algorithm>
+#include <random>
+
+std::vector<uint32_t>	generateGridIndices(uint32_t size, uint32_t seed)
+{
+	std::mt19937			generator(seed);
+	std::vector<uint32_t>	triangles;
+	std::vector<uint32_t>	indices;
+
+	for (uint32_t i = 0; i < size * size * 2; i++)
+		triangles.push_back(i);
+	std::shuffle(triangles.begin(), triangles.end(), generator);
+
+	for (uint32_t triangle : triangles)
+	{
+		uint32_t	quad = triangle / 2;
+		uint32_t	a = (quad / size) * (size + 1) + quad % size;
+		uint32_t	b = a + 1;
+		uint32_t	c = a + size + 1;
+		uint32_t	d = c + 1;
+
+		if (triangle % 2 == 0)
+			indices.insert(indices.end(), {a, c, b});
+		else
+			indices.insert(indices.end(), {b, c, d});
+	}
+
+	return (indices);
+}
@@ -0,0 +1,21 @@
+#ifndef GRID_HPP
+# define GRID_HPP
+
+# include <defineCore.hpp>
+
+# include <vector>
+# include <cstdint>
+
+/**
+ * @brief Generate indices of a grid of size * size quads, two triangles per
+ * quad, with triangles shuffled. Worst case order for vertex cache, shared by
+ * unit tests and benchmarks.
+ *
+ * @param size Number of quads per side, grid has (size + 1)^2 vertices.
+ * @param seed Seed of the shuffle, same seed give same indices.
+ *
+ * @return Indices of triangles, with the same winding for each triangle.
+ */
+std::vector<uint32_t>	generateGridIndices(uint32_t size, uint32_t seed);
+
+#endif
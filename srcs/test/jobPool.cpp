@@ -0,0 +1,87 @@
+#include <test/test.hpp>
+
+#include <engine/jobs/JobPool.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+void	testJobPool(void)
+{
+	JobPool	jobPool;
+
+	jobPool.init(4);
+	CHECK(jobPool.getNbThreads() >= 1);
+
+	// Each job run exactly once, on a valid thread
+	const uint32_t				nbJobs = 1000;
+	std::vector<uint32_t>		runs(nbJobs, 0);
+	std::atomic<bool>			validThreads(true);
+
+	jobPool.run(nbJobs, [&](uint32_t jobId, uint32_t threadId)
+	{
+		runs[jobId]++;
+		if (threadId >= jobPool.getNbThreads())
+			validThreads = false;
+	});
+
+	bool	allOnce = true;
+	for (uint32_t count : runs)
+		allOnce = allOnce && count == 1;
+	CHECK(allOnce);
+	CHECK(validThreads);
+
+	// Pool is reusable, and run wait for all jobs before returning
+	for (int i = 0; i < 8; i++)
+	{
+		std::atomic<uint32_t>	sum(0);
+
+		jobPool.run(100, [&](uint32_t jobId, uint32_t threadId)
+		{
+			(void)threadId;
+			sum += jobId;
+		});
+		CHECK(sum == 4950);
+	}
+
+	// No job is a no-op
+	bool	called = false;
+	jobPool.run(0, [&](uint32_t jobId, uint32_t threadId)
+	{
+		(void)jobId;
+		(void)threadId;
+		called = true;
+	});
+	CHECK(!called);
+
+	// Exception of a job is rethrown by run, after every job is done
+	std::atomic<uint32_t>	nbRun(0);
+	bool					thrown = false;
+	try
+	{
+		jobPool.run(100, [&](uint32_t jobId, uint32_t threadId)
+		{
+			(void)threadId;
+			nbRun++;
+			if (jobId % 10 == 3)
+				throw std::runtime_error("job failed");
+		});
+	}
+	catch (const std::runtime_error &e)
+	{
+		thrown = true;
+	}
+	CHECK(thrown);
+	CHECK(nbRun == 100);
+
+	// Pool still works after a failed run
+	std::atomic<uint32_t>	sum(0);
+	jobPool.run(10, [&](uint32_t jobId, uint32_t threadId)
+	{
+		(void)threadId;
+		sum += jobId;
+	});
+	CHECK(sum == 45);
+
+	jobPool.destroy();
+}
@@ -0,0 +1,51 @@
+#include <test/test.hpp>
+
+#include <iostream>
+#include <exception>
+
+static int	nbChecks = 0;
+static int	nbFailedChecks = 0;
+
+static void	runTest(const char *name, void (*test)(void));
+
+int	main(void)
+{
+	runTest("string", testString);
+	runTest("cameraPath", testCameraPath);
+	runTest("meshOptimizer", testMeshOptimizer);
+	runTest("jobPool", testJobPool);
+
+	std::cout << nbChecks - nbFailedChecks << "/" << nbChecks << " checks passed" << std::endl;
+
+	return (nbFailedChecks == 0 ? 0 : 1);
+}
+
+
+void	checkTest(bool success, const char *expression, const char *file, int line)
+{
+	nbChecks++;
+	if (success)
+		return ;
+
+	nbFailedChecks++;
+	std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+}
+
+
+static void	runTest(const char *name, void (*test)(void))
+{
+	int	nbFailedBefore = nbFailedChecks;
+
+	// An exception fail the test, next ones still run
+	try
+	{
+		test();
+	}
+	catch (const std::exception &e)
+	{
+		nbFailedChecks++;
+		std::cerr << name << ": unexpected exception: " << e.what() << std::endl;
+	}
+
+	std::cout << (nbFailedChecks == nbFailedBefore ? "[OK]   " : "[FAIL] ") << name << std::endl;
+}
@@ -0,0 +1,92 @@
+#include <test/test.hpp>
+
+#include <engine/mesh/MeshOptimizer.hpp>
+#include <test/grid.hpp>
+
+#include <array>
+#include <algorithm>
+#include <vector>
+
+// Sorted triangles, with first index rotated to smallest, to compare meshes
+static std::vector<std::array<uint32_t, 3>>	getTriangles(const std::vector<uint32_t> &indices)
+{
+	std::vector<std::array<uint32_t, 3>>	triangles;
+
+	for (size_t i = 0; i + 2 < indices.size(); i += 3)
+	{
+		std::array<uint32_t, 3>	triangle = {indices[i], indices[i + 1], indices[i + 2]};
+
+		std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+		triangles.push_back(triangle);
+	}
+	std::sort(triangles.begin(), triangles.end());
+
+	return (triangles);
+}
+
+
+static void	testComputeAcmr(void)
+{
+	// One triangle always cost its 3 vertices
+	CHECK_NEAR(computeAcmr({0, 1, 2}, 3), 3.0f, 1e-6f);
+	// Second triangle reuse 2 cached vertices
+	CHECK_NEAR(computeAcmr({0, 1, 2, 2, 1, 3}, 4), 2.0f, 1e-6f);
+	// Same triangle twice is fully cached the second time
+	CHECK_NEAR(computeAcmr({0, 1, 2, 0, 1, 2}, 3), 1.5f, 1e-6f);
+	// Cache of 3 evict first vertex before it is used again
+	CHECK_NEAR(computeAcmr({0, 1, 2, 3, 4, 5, 0, 1, 2}, 6, 3), 3.0f, 1e-6f);
+	CHECK(computeAcmr({}, 0) == 0.0f);
+}
+
+
+static void	testOptimizeVertexCache(void)
+{
+	const uint32_t			size = 64;
+	const uint32_t			nbVertex = (size + 1) * (size + 1);
+	std::vector<uint32_t>	source = generateGridIndices(size, TEST_SEED);
+	std::vector<uint32_t>	indices = source;
+
+	optimizeVertexCache(indices, nbVertex);
+
+	// Same triangles, same winding, better order
+	CHECK(indices.size() == source.size());
+	CHECK(getTriangles(indices) == getTriangles(source));
+	CHECK(computeAcmr(indices, nbVertex) < computeAcmr(source, nbVertex));
+	CHECK(computeAcmr(indices, nbVertex) < 1.0f);
+}
+
+
+static void	testOptimizeVertexFetch(void)
+{
+	// Vertex 1 is unused, others are remapped by first use
+	std::vector<uint32_t>	indices = {4, 2, 0, 0, 2, 3};
+	std::vector<uint32_t>	source = indices;
+	std::vector<uint32_t>	remap;
+	uint32_t				nbUsed = optimizeVertexFetch(indices, 5, remap);
+
+	CHECK(nbUsed == 4);
+	CHECK((indices == std::vector<uint32_t>{0, 1, 2, 2, 1, 3}));
+	CHECK(remap.size() == 5);
+	CHECK(remap[1] == UINT32_MAX);
+	for (size_t i = 0; i < source.size(); i++)
+		CHECK(remap[source[i]] == indices[i]);
+
+	// Vertices of a grid are all used, remap is a permutation
+	const uint32_t	size = 16;
+	const uint32_t	nbVertex = (size + 1) * (size + 1);
+
+	indices = generateGridIndices(size, TEST_SEED);
+	nbUsed = optimizeVertexFetch(indices, nbVertex, remap);
+	CHECK(nbUsed == nbVertex);
+	std::sort(remap.begin(), remap.end());
+	for (uint32_t i = 0; i < nbVertex; i++)
+		CHECK(remap[i] == i);
+}
+
+
+void	testMeshOptimizer(void)
+{
+	testComputeAcmr();
+	testOptimizeVertexCache();
+	testOptimizeVertexFetch();
+}
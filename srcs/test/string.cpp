@@ -0,0 +1,91 @@
+#include <test/test.hpp>
+
+#include <program/parsing/string.hpp>
+
+static void	testStrToInt(void)
+{
+	int	value = 0;
+
+	CHECK(strToInt("42", value) && value == 42);
+	CHECK(strToInt("-42", value) && value == -42);
+	CHECK(strToInt("+7", value) && value == 7);
+	CHECK(strToInt("2147483647", value) && value == 2147483647);
+	CHECK(strToInt("-2147483648", value) && value == -2147483647 - 1);
+
+	// Out of int range, too many digits or not a number
+	CHECK(!strToInt("2147483648", value));
+	CHECK(!strToInt("-2147483649", value));
+	CHECK(!strToInt("00000000001", value));
+	CHECK(!strToInt("", value));
+	CHECK(!strToInt("+", value));
+	CHECK(!strToInt("-", value));
+	CHECK(!strToInt("12a", value));
+	CHECK(!strToInt("1.5", value));
+
+	// Only the view is parsed, not the rest of the buffer
+	std::string_view	view = std::string_view("123456").substr(0, 3);
+	CHECK(strToInt(view, value) && value == 123);
+}
+
+
+static void	testStrToFloat(void)
+{
+	float	value = 0.0f;
+
+	CHECK(strToFloat("1.5", value) && value == 1.5f);
+	CHECK(strToFloat("-0.25", value) && value == -0.25f);
+	CHECK(strToFloat("5.", value) && value == 5.0f);
+	CHECK(strToFloat("3", value) && value == 3.0f);
+
+	CHECK(!strToFloat(".5", value));
+	CHECK(!strToFloat("1.2.3", value));
+	CHECK(!strToFloat("", value));
+	CHECK(!strToFloat("1e5", value));
+	CHECK(!strToFloat("abc", value));
+
+	std::string_view	view = std::string_view("2.75 rest").substr(0, 4);
+	CHECK(strToFloat(view, value) && value == 2.75f);
+}
+
+
+static void	testSplitView(void)
+{
+	std::vector<std::string_view>	words = splitView("  a bb  ccc ", ' ');
+
+	CHECK(words.size() == 3);
+	if (words.size() == 3)
+	{
+		CHECK(words[0] == "a");
+		CHECK(words[1] == "bb");
+		CHECK(words[2] == "ccc");
+	}
+
+	CHECK(splitView("", ' ').empty());
+	CHECK(splitView("   ", ' ').empty());
+	CHECK(splitView("x", ' ').size() == 1);
+
+	// Views point into the source, without copy
+	std::string	line = "v 1 2";
+	words = splitView(line, ' ');
+	CHECK(words.size() == 3 && words[2].data() == line.data() + 4);
+
+	// Other split flavours give the same words
+	std::vector<std::string>	copies = split("  a bb  ccc ", ' ');
+	CHECK(copies.size() == 3 && copies[1] == "bb");
+
+	size_t	nbLazy = 0;
+	for (std::string_view word : splitLazy("  a bb  ccc ", ' '))
+	{
+		CHECK(!word.empty());
+		nbLazy++;
+	}
+	CHECK(nbLazy == 3);
+}
+
+
+void	testString(void)
+{
+	testStrToInt();
+	testStrToFloat();
+	testSplitView();
+}
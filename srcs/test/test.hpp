@@ -0,0 +1,29 @@
+#ifndef TEST_HPP
+# define TEST_HPP
+
+# include <defineCore.hpp>
+
+# include <cmath>
+
+// Failed checks are counted and printed, without stopping the test
+# define CHECK(expression) checkTest((expression), #expression, __FILE__, __LINE__)
+# define CHECK_NEAR(a, b, epsilon) CHECK(std::fabs((a) - (b)) <= (epsilon))
+// Generated inputs use a fixed seed
+# define TEST_SEED 42
+
+/**
+ * @brief Record result of a check, print it when failed.
+ *
+ * @param success If check passed.
+ * @param expression Checked expression, as written in test.
+ * @param file File of check.
+ * @param line Line of check.
+ */
+void	checkTest(bool success, const char *expression, const char *file, int line);
+
+void	testString(void);
+void	testCameraPath(void);
+void	testMeshOptimizer(void);
+void	testJobPool(void);
+
+#endif